@@ -0,0 +1,126 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @enum FlightEventType
+ * @brief Kinds of events kept by a FlightRecorder.
+ */
+enum class FlightEventType : std::uint8_t {
+    Dispatch,      /**< A request was assigned to a server */
+    Finish,        /**< A server finished a request */
+    Reject,        /**< A request could not be processed within the runtime */
+    NoServer,      /**< Requests were waiting but every server was busy */
+    Generate,      /**< A new random request was added to the queue */
+    ServerAdded,   /**< The balancer added a server */
+    ServerRemoved  /**< The balancer removed a server */
+};
+
+/**
+ * @struct FlightEvent
+ * @brief A fixed-size record of one simulation event.
+ *
+ * Events hold only plain numbers so recording never allocates; they are
+ * turned into text only when the recorder is dumped.
+ */
+struct FlightEvent {
+    int clockCycle;       /**< The clock cycle at which the event happened */
+    FlightEventType type; /**< What happened */
+    int serverId;         /**< The server involved, or 0 for balancer-wide events */
+    int queueSize;        /**< Request queue depth at the time of the event, or -1 if unknown */
+    int value;            /**< Event specific value (task time, server count, ...) */
+};
+
+/**
+ * @brief Gets a printable name for a flight event type.
+ *
+ * @param type The event type.
+ * @return A short, constant name for the type.
+ */
+inline const char* flightEventName(FlightEventType type) {
+    switch (type) {
+        case FlightEventType::Dispatch: return "DISPATCH";
+        case FlightEventType::Finish: return "FINISH";
+        case FlightEventType::Reject: return "REJECT";
+        case FlightEventType::NoServer: return "NO_SERVER";
+        case FlightEventType::Generate: return "GENERATE";
+        case FlightEventType::ServerAdded: return "SERVER_ADDED";
+        case FlightEventType::ServerRemoved: return "SERVER_REMOVED";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @class FlightRecorder
+ * @brief Always-on ring buffer holding the most recent Capacity events.
+ *
+ * Recording is a single store and an index increment; once full, the oldest
+ * event is overwritten. There is one writer per recorder (its owning server
+ * or balancer), so no locks are needed, and memory use is constant no matter
+ * how long the simulation runs.
+ *
+ * @tparam Capacity Number of events retained. Must be a power of two.
+ */
+template <std::size_t Capacity>
+class FlightRecorder {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Records an event, overwriting the oldest one if the buffer is full.
+     *
+     * @param event The event to record.
+     */
+    void record(const FlightEvent& event) {
+        events[head & (Capacity - 1)] = event;
+        ++head;
+    }
+
+    /**
+     * @brief Gets the number of events currently held.
+     *
+     * @return The number of retained events, at most Capacity.
+     */
+    std::size_t size() const {
+        return head < Capacity ? static_cast<std::size_t>(head) : Capacity;
+    }
+
+    /**
+     * @brief Gets the total number of events ever recorded.
+     *
+     * @return The number of calls to record().
+     */
+    std::uint64_t totalRecorded() const {
+        return head;
+    }
+
+    /**
+     * @brief Writes the retained events, oldest first, to a stream.
+     *
+     * @param out The stream to write to.
+     * @param label A heading identifying the owner of this recorder.
+     */
+    void dump(std::ostream& out, const std::string& label) const {
+        out << label << " (last " << size() << " of " << head << " events)" << std::endl;
+        for (std::uint64_t i = head - size(); i < head; ++i) {
+            const FlightEvent& event = events[i & (Capacity - 1)];
+            out << "  Clock cycle " << event.clockCycle << ": " << flightEventName(event.type)
+                << " | Server: " << event.serverId;
+            if (event.queueSize >= 0) {
+                out << " | Queue: " << event.queueSize;
+            }
+            out << " | Value: " << event.value << std::endl;
+        }
+    }
+
+private:
+    std::array<FlightEvent, Capacity> events{}; /**< Ring storage for the events */
+    std::uint64_t head = 0;                     /**< Total events recorded; next write slot modulo Capacity */
+};
+
+#endif // FLIGHTRECORDER_H
@@ -0,0 +1,230 @@
+#include "flowtable.h"
+#include <algorithm>
+#include <bit>
+#ifdef __SSE2__
+#include <emmintrin.h> // For comparing a group of control tags at once
+#endif
+
+/**
+ * @brief Mixes a flow key into a 64-bit hash.
+ * @param key The flow's key.
+ * @return The hash; the low 7 bits form the control tag, the rest pick the group.
+ */
+static std::uint64_t hashKey(const FlowKey& key) {
+    std::uint64_t h = (std::uint64_t(key.ipIn) << 32) | key.ipOut;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Builds the flow key of a request from its already parsed addresses.
+ * @param request The request.
+ * @return The flow key.
+ */
+FlowKey FlowKey::fromRequest(const Request& request) {
+    return {request.getIpInAddress(), request.getIpOutAddress()};
+}
+
+/**
+ * @brief Constructs an empty FlowTable with at least initialCapacity slots.
+ * @param initialCapacity Minimum number of slots.
+ */
+FlowTable::FlowTable(std::size_t initialCapacity)
+    : used(0), deleted(0), agingCursor(0), flowsExpired(0) {
+    std::size_t slotCount = std::bit_ceil(std::max(initialCapacity, GROUP_SIZE));
+    control.assign(slotCount, EMPTY);
+    slots.resize(slotCount);
+}
+
+/**
+ * @brief Gets the tags in a group that equal tag, one bit per slot.
+ * @param group First slot of the group.
+ * @param tag The tag to match.
+ * @return The match mask.
+ */
+std::uint32_t FlowTable::matchGroup(std::size_t group, std::int8_t tag) const {
+#ifdef __SSE2__
+    __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&control[group]));
+    return std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(tag))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < GROUP_SIZE; ++i) {
+        if (control[group + i] == tag) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Probes the key's groups until it is found or an empty slot proves it absent.
+ * @param key The flow's key.
+ * @param hash The key's hash.
+ * @return The slot index, or capacity() if absent.
+ */
+std::size_t FlowTable::findSlot(const FlowKey& key, std::uint64_t hash) const {
+    std::size_t groupMask = capacity() / GROUP_SIZE - 1;
+    std::size_t group = (hash >> 7) & groupMask;
+    std::int8_t tag = std::int8_t(hash & 0x7F);
+
+    // Triangular probing visits every group once when the group count is a power of two
+    for (std::size_t step = 0; step <= groupMask; ++step) {
+        std::size_t base = group * GROUP_SIZE;
+        for (std::uint32_t match = matchGroup(base, tag); match; match &= match - 1) {
+            std::size_t slot = base + std::countr_zero(match);
+            if (slots[slot].key == key) return slot;
+        }
+        if (matchGroup(base, EMPTY)) return capacity();
+        group = (group + step + 1) & groupMask;
+    }
+    return capacity();
+}
+
+/**
+ * @brief Finds a flow by key.
+ * @param key The flow's key.
+ * @return The flow, or nullptr if it is not tracked.
+ */
+Flow* FlowTable::find(const FlowKey& key) {
+    std::size_t slot = findSlot(key, hashKey(key));
+    return slot == capacity() ? nullptr : &slots[slot];
+}
+
+/**
+ * @brief Finds or inserts a flow and updates its last-seen cycle.
+ * @param key The flow's key.
+ * @param currentCycle The current clock cycle.
+ * @param serverId Server assigned to a new flow.
+ * @return The flow.
+ */
+Flow& FlowTable::touch(const FlowKey& key, int currentCycle, int serverId) {
+    std::uint64_t hash = hashKey(key);
+    std::size_t slot = findSlot(key, hash);
+    if (slot != capacity()) {
+        slots[slot].lastSeen = currentCycle;
+        return slots[slot];
+    }
+
+    // Keep the load (including deleted markers) under 7/8; grow only if live flows need it
+    if ((used + deleted + 1) * 8 > capacity() * 7) {
+        rehash(used * 2 >= capacity() ? capacity() * 2 : capacity());
+    }
+
+    std::size_t groupMask = capacity() / GROUP_SIZE - 1;
+    std::size_t group = (hash >> 7) & groupMask;
+    for (std::size_t step = 0;; ++step) {
+        std::size_t base = group * GROUP_SIZE;
+        std::uint32_t free = matchGroup(base, EMPTY) | matchGroup(base, DELETED);
+        if (free) {
+            slot = base + std::countr_zero(free);
+            break;
+        }
+        group = (group + step + 1) & groupMask;
+    }
+
+    if (control[slot] == DELETED) deleted--;
+    control[slot] = std::int8_t(hash & 0x7F);
+    slots[slot] = {key, serverId, currentCycle, currentCycle, 0, 0};
+    used++;
+    return slots[slot];
+}
+
+/**
+ * @brief Expires idle flows from the next slotBudget slots, or more if the table needs it.
+ * @param currentCycle The current clock cycle.
+ * @param maxIdle Maximum idle time in clock cycles.
+ * @param slotBudget Minimum number of slots to examine.
+ */
+void FlowTable::age(int currentCycle, int maxIdle, std::size_t slotBudget) {
+    // Sweep the whole table at least once every maxIdle calls, so a flow is gone at most
+    // 2 * maxIdle cycles after its last request however fast new flows arrive
+    std::size_t sweep = (capacity() + std::max(1, maxIdle) - 1) / std::max(1, maxIdle);
+    slotBudget = std::max(slotBudget, sweep);
+    std::size_t slotMask = capacity() - 1;
+    for (std::size_t i = 0; i < slotBudget && used > 0; ++i) {
+        if (control[agingCursor] >= 0 && currentCycle - slots[agingCursor].lastSeen > maxIdle) {
+            control[agingCursor] = DELETED;
+            used--;
+            deleted++;
+            flowsExpired++;
+        }
+        agingCursor = (agingCursor + 1) & slotMask;
+    }
+}
+
+/**
+ * @brief Rebuilds the table into newCapacity slots.
+ * @param newCapacity The new number of slots.
+ */
+void FlowTable::rehash(std::size_t newCapacity) {
+    std::vector<std::int8_t> oldControl = std::move(control);
+    std::vector<Flow> oldSlots = std::move(slots);
+    control.assign(newCapacity, EMPTY);
+    slots.assign(newCapacity, Flow{});
+    deleted = 0;
+    agingCursor = 0;
+
+    std::size_t groupMask = newCapacity / GROUP_SIZE - 1;
+    for (std::size_t i = 0; i < oldControl.size(); ++i) {
+        if (oldControl[i] < 0) continue;
+        std::uint64_t hash = hashKey(oldSlots[i].key);
+        std::size_t group = (hash >> 7) & groupMask;
+        for (std::size_t step = 0;; ++step) {
+            std::size_t base = group * GROUP_SIZE;
+            std::uint32_t free = matchGroup(base, EMPTY);
+            if (free) {
+                std::size_t slot = base + std::countr_zero(free);
+                control[slot] = oldControl[i];
+                slots[slot] = oldSlots[i];
+                break;
+            }
+            group = (group + step + 1) & groupMask;
+        }
+    }
+}
+
+/**
+ * @brief Gets up to count flows ordered by request count.
+ * @param count Maximum number of flows.
+ * @return The busiest flows.
+ */
+std::vector<Flow> FlowTable::topFlows(std::size_t count) const {
+    std::vector<Flow> flows;
+    flows.reserve(used);
+    for (std::size_t i = 0; i < capacity(); ++i) {
+        if (control[i] >= 0) flows.push_back(slots[i]);
+    }
+    count = std::min(count, flows.size());
+    std::partial_sort(flows.begin(), flows.begin() + count, flows.end(), [](const Flow& a, const Flow& b) {
+        return a.requests > b.requests;
+    });
+    flows.resize(count);
+    return flows;
+}
+
+/**
+ * @brief Gets the number of tracked flows.
+ * @return The flow count.
+ */
+std::size_t FlowTable::size() const {
+    return used;
+}
+
+/**
+ * @brief Gets the number of flows removed by aging.
+ * @return The expired flow count.
+ */
+long long FlowTable::getFlowsExpired() const {
+    return flowsExpired;
+}
+
+/**
+ * @brief Gets the total number of slots.
+ * @return The slot count.
+ */
+std::size_t FlowTable::capacity() const {
+    return control.size();
+}
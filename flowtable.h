@@ -0,0 +1,147 @@
+#ifndef FLOWTABLE_H
+#define FLOWTABLE_H
+
+#include "request.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct FlowKey
+ * @brief Identifies a flow by its source and destination IPv4 addresses.
+ */
+struct FlowKey {
+    std::uint32_t ipIn;  /**< Source address in host byte order */
+    std::uint32_t ipOut; /**< Destination address in host byte order */
+
+    /**
+     * @brief Builds the flow key of a request.
+     * @param request The request whose addresses form the key.
+     * @return The key, from the addresses the request parsed when it was built; malformed addresses map to 0.
+     */
+    static FlowKey fromRequest(const Request& request);
+
+    bool operator==(const FlowKey& other) const = default;
+};
+
+/**
+ * @struct Flow
+ * @brief Connection-tracking state for one (ipIn, ipOut) pair.
+ */
+struct Flow {
+    FlowKey key;            /**< The flow's addresses */
+    int serverId;           /**< Server the flow is pinned to */
+    int firstSeen;          /**< Clock cycle of the flow's first request */
+    int lastSeen;           /**< Clock cycle of the flow's most recent request */
+    long long requests;     /**< Requests of this flow that were processed */
+    long long cycles;       /**< Total task time (in clock cycles) of those requests */
+};
+
+/**
+ * @class FlowTable
+ * @brief Open-addressing hash table of flows, laid out like a Swiss table.
+ *
+ * Slots are grouped sixteen at a time, each with a one-byte control tag holding
+ * seven bits of the key's hash (or an empty/deleted marker). A lookup compares
+ * a whole group of tags at once (with SSE2 where available) and only touches
+ * the slots whose tags match. Flows that have been idle too long are removed by
+ * age(), which scans a bounded number of slots per call so expiry is spread
+ * across the run instead of pausing it. The scan grows with the table so that
+ * every slot is visited once per maxIdle calls, which keeps the table's size
+ * proportional to the rate of new flows.
+ */
+class FlowTable {
+public:
+    /**
+     * @brief Constructs an empty FlowTable.
+     * @param initialCapacity Minimum number of slots to start with.
+     */
+    explicit FlowTable(std::size_t initialCapacity = 1024);
+
+    /**
+     * @brief Finds a flow.
+     * @param key The flow's key.
+     * @return A pointer to the flow, or nullptr if it is not tracked. Invalidated by touch().
+     */
+    Flow* find(const FlowKey& key);
+
+    /**
+     * @brief Finds a flow, inserting it if absent, and marks it as seen.
+     * @param key The flow's key.
+     * @param currentCycle The current clock cycle.
+     * @param serverId Server to pin a newly inserted flow to.
+     * @return A reference to the flow, valid until the next call to touch().
+     */
+    Flow& touch(const FlowKey& key, int currentCycle, int serverId);
+
+    /**
+     * @brief Removes flows idle for more than maxIdle cycles, scanning a bounded number of slots.
+     * Successive calls continue where the previous one stopped. At least capacity / maxIdle
+     * slots are scanned, so the whole table is covered every maxIdle calls.
+     * @param currentCycle The current clock cycle.
+     * @param maxIdle Cycles a flow may go unseen before it is removed.
+     * @param slotBudget Minimum number of slots examined by this call.
+     */
+    void age(int currentCycle, int maxIdle, std::size_t slotBudget);
+
+    /**
+     * @brief Gets the flows with the most requests.
+     * @param count Maximum number of flows to return.
+     * @return Up to count flows, busiest first.
+     */
+    std::vector<Flow> topFlows(std::size_t count) const;
+
+    /**
+     * @brief Gets the number of tracked flows.
+     * @return The number of flows in the table.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the number of flows removed by aging.
+     * @return The number of expired flows.
+     */
+    long long getFlowsExpired() const;
+
+private:
+    static constexpr std::size_t GROUP_SIZE = 16;  ///< Slots compared per probe step
+    static constexpr std::int8_t EMPTY = -128;     ///< Control tag of a never-used slot
+    static constexpr std::int8_t DELETED = -2;     ///< Control tag of an erased slot
+
+    /**
+     * @brief Finds the slot holding key.
+     * @param key The flow's key.
+     * @param hash The key's hash.
+     * @return The slot index, or capacity() if not found.
+     */
+    std::size_t findSlot(const FlowKey& key, std::uint64_t hash) const;
+
+    /**
+     * @brief Gets a bitmask of the slots in a group whose tag equals tag.
+     * @param group Index of the first slot of the group.
+     * @param tag The control tag to match.
+     * @return Bit i is set when slot group + i matches.
+     */
+    std::uint32_t matchGroup(std::size_t group, std::int8_t tag) const;
+
+    /**
+     * @brief Rebuilds the table with the given number of slots, dropping deleted markers.
+     * @param newCapacity The new slot count, a power of two and at least GROUP_SIZE.
+     */
+    void rehash(std::size_t newCapacity);
+
+    /**
+     * @brief Gets the total number of slots.
+     * @return The slot count.
+     */
+    std::size_t capacity() const;
+
+    std::vector<std::int8_t> control; ///< One tag per slot: hash bits, EMPTY or DELETED
+    std::vector<Flow> slots;          ///< Flow storage, parallel to control
+    std::size_t used;                 ///< Slots holding a flow
+    std::size_t deleted;              ///< Slots marked DELETED
+    std::size_t agingCursor;          ///< Next slot examined by age()
+    long long flowsExpired;           ///< Flows removed by age()
+};
+
+#endif // FLOWTABLE_H
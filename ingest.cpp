@@ -0,0 +1,391 @@
+#include "ingest.h"
+#include "ipv4.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Bytes read from one input per poll, so a fast producer cannot starve the clock
+static const std::size_t READ_CHUNK = 64 * 1024;
+static const int MAX_EVENTS = 64;
+
+/**
+ * @brief Builds an exception describing a failed system call.
+ * @param what The operation that failed.
+ * @return The exception, including strerror(errno).
+ */
+static std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief Constructs an ingestor reading records from stdin.
+ * @param format The record format.
+ */
+RequestIngestor::RequestIngestor(Format format)
+    : format(format), epollFd(-1), listenFd(-1), readStdinDirectly(false), stdinFlags(-1),
+      recordsReceived(0), recordsMalformed(0), maxTaskTime(std::numeric_limits<int>::max()), bytesReceived(0),
+      batchReadAt(std::chrono::steady_clock::time_point::max()) {
+    epollFd = epoll_create1(0);
+    if (epollFd < 0) {
+        throw systemError("epoll_create1");
+    }
+    stdinFlags = fcntl(STDIN_FILENO, F_GETFL);
+    try {
+        readStdinDirectly = !watch(STDIN_FILENO);
+    } catch (...) {
+        closeAll(); // The destructor does not run for a partly constructed object
+        throw;
+    }
+    connections.push_back({STDIN_FILENO, std::string(), false});
+}
+
+/**
+ * @brief Constructs an ingestor accepting clients on a Unix domain socket.
+ * @param socketPath Path of the socket file.
+ * @param format The record format.
+ */
+RequestIngestor::RequestIngestor(const std::string& socketPath, Format format)
+    : format(format), epollFd(-1), listenFd(-1), socketPath(socketPath), readStdinDirectly(false), stdinFlags(-1),
+      recordsReceived(0), recordsMalformed(0), maxTaskTime(std::numeric_limits<int>::max()), bytesReceived(0),
+      batchReadAt(std::chrono::steady_clock::time_point::max()) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    try {
+        epollFd = epoll_create1(0);
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (epollFd < 0 || listenFd < 0) {
+            throw systemError("socket");
+        }
+        unlink(socketPath.c_str());
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            throw systemError("bind " + socketPath);
+        }
+        if (listen(listenFd, SOMAXCONN) < 0) {
+            throw systemError("listen " + socketPath);
+        }
+        watch(listenFd);
+    } catch (...) {
+        closeAll(); // The destructor does not run for a partly constructed object
+        throw;
+    }
+}
+
+/**
+ * @brief Closes every input, restores stdin and removes the socket file.
+ */
+RequestIngestor::~RequestIngestor() {
+    closeAll();
+}
+
+/**
+ * @brief Releases every file descriptor and restores stdin; safe on a partly constructed ingestor.
+ */
+void RequestIngestor::closeAll() {
+    for (const auto& connection : connections) {
+        if (connection.fd != STDIN_FILENO) {
+            close(connection.fd);
+        }
+    }
+    if (stdinFlags >= 0) {
+        fcntl(STDIN_FILENO, F_SETFL, stdinFlags);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    connections.clear();
+    stdinFlags = listenFd = epollFd = -1;
+}
+
+/**
+ * @brief Makes fd non-blocking and watches it for input.
+ * @param fd The file descriptor.
+ * @return false if epoll refuses it (regular files).
+ */
+bool RequestIngestor::watch(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    epoll_event event{};
+    event.events = EPOLLIN; // Level-triggered: unread data keeps signalling
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        if (errno == EPERM) {
+            return false;
+        }
+        throw systemError("epoll_ctl");
+    }
+    return true;
+}
+
+/**
+ * @brief Waits for input and returns up to MAX_BATCH parsed requests.
+ * @param timeoutMs Maximum wait in milliseconds.
+ * @param batch Receives the requests.
+ * @return Number of requests appended.
+ */
+std::size_t RequestIngestor::poll(int timeoutMs, std::vector<Request>& batch) {
+    std::size_t before = batch.size();
+    std::size_t limit = before + MAX_BATCH;
+    batchReadAt = std::chrono::steady_clock::time_point::max();
+
+    // Records left over from a full batch are handed out before reading more
+    for (auto& connection : connections) {
+        parseRecords(connection, batch, limit);
+    }
+
+    if (batch.size() < limit) {
+        int wait = (batch.size() > before || readStdinDirectly) ? 0 : timeoutMs;
+        epoll_event events[MAX_EVENTS];
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, wait);
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto it = std::find_if(connections.begin(), connections.end(), [fd](const Connection& c) { return c.fd == fd; });
+            if (it == connections.end()) {
+                continue;
+            }
+            if (!it->ended && !readAvailable(*it)) {
+                it->ended = true;
+            }
+            parseRecords(*it, batch, limit);
+        }
+
+        if (readStdinDirectly && !connections.empty() && !connections[0].ended) {
+            connections[0].ended = !readAvailable(connections[0]);
+            parseRecords(connections[0], batch, limit);
+        }
+    }
+
+    // Drop inputs that have ended once every complete record has been returned
+    if (batch.size() < limit) {
+        std::vector<int> finished;
+        for (const auto& connection : connections) {
+            if (connection.ended) {
+                recordsMalformed += connection.buffer.empty() ? 0 : 1; // Truncated final record
+                finished.push_back(connection.fd);
+            }
+        }
+        for (int fd : finished) {
+            closeConnection(fd);
+        }
+    }
+    return batch.size() - before;
+}
+
+/**
+ * @brief Reads up to READ_CHUNK bytes from a connection into its buffer.
+ * @param connection The connection.
+ * @return false on end of file or error.
+ */
+bool RequestIngestor::readAvailable(Connection& connection) {
+    std::size_t total = 0;
+    char chunk[16 * 1024];
+    while (total < READ_CHUNK) {
+        ssize_t count = read(connection.fd, chunk, sizeof(chunk));
+        if (count > 0) {
+            if (connection.buffer.empty()) {
+                connection.readAt = std::chrono::steady_clock::now();
+            }
+            connection.buffer.append(chunk, count);
+            total += count;
+            bytesReceived += count;
+        } else if (count == 0) {
+            return false;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parses complete records from the front of a connection's buffer.
+ * @param connection The connection.
+ * @param batch Receives the requests.
+ * @param limit Batch size at which parsing stops.
+ */
+void RequestIngestor::parseRecords(Connection& connection, std::vector<Request>& batch, std::size_t limit) {
+    std::string_view pending = connection.buffer;
+    std::size_t consumed = 0;
+    std::size_t before = batch.size();
+
+    while (batch.size() < limit) {
+        std::string_view rest = pending.substr(consumed);
+        if (format == Format::Text) {
+            std::size_t newline = rest.find('\n');
+            if (newline == std::string_view::npos) break;
+            parseTextRecord(rest.substr(0, newline), batch);
+            consumed += newline + 1;
+        } else {
+            if (rest.size() < sizeof(std::uint16_t)) break;
+            std::uint16_t length;
+            std::memcpy(&length, rest.data(), sizeof(length));
+            if (rest.size() < sizeof(length) + length) break;
+            parseBinaryRecord(rest.substr(sizeof(length), length), batch);
+            consumed += sizeof(length) + length;
+        }
+    }
+    connection.buffer.erase(0, consumed);
+
+    // Bytes still buffered keep their read time, so records delayed by a full batch are not under-reported
+    if (batch.size() > before) {
+        batchReadAt = std::min(batchReadAt, connection.readAt);
+    }
+}
+
+/**
+ * @brief Parses "ipIn ipOut time jobType".
+ * @param line The record.
+ * @param batch Receives the request if valid.
+ */
+void RequestIngestor::parseTextRecord(std::string_view line, std::vector<Request>& batch) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    if (line.empty()) {
+        return; // Blank lines are ignored
+    }
+
+    std::string_view fields[4];
+    int fieldCount = 0;
+    std::size_t position = 0;
+    while (position < line.size() && fieldCount < 4) {
+        std::size_t end = line.find(' ', position);
+        if (end == std::string_view::npos) end = line.size();
+        if (end > position) fields[fieldCount++] = line.substr(position, end - position);
+        position = end + 1;
+    }
+
+    std::uint32_t ipIn, ipOut;
+    int time = 0;
+    bool valid = fieldCount == 4 && position >= line.size() &&
+                 parseIpv4(fields[0], ipIn) && parseIpv4(fields[1], ipOut) &&
+                 std::from_chars(fields[2].data(), fields[2].data() + fields[2].size(), time).ptr ==
+                     fields[2].data() + fields[2].size() &&
+                 time > 0 && time <= maxTaskTime && fields[3].size() == 1 && (fields[3][0] == 'P' || fields[3][0] == 'S');
+    if (!valid) {
+        recordsMalformed++;
+        return;
+    }
+    batch.emplace_back(ipIn, ipOut, time, fields[3][0]);
+    recordsReceived++;
+}
+
+/**
+ * @brief Parses a binary payload of ipIn, ipOut, time and jobType.
+ * @param payload The payload.
+ * @param batch Receives the request if valid.
+ */
+void RequestIngestor::parseBinaryRecord(std::string_view payload, std::vector<Request>& batch) {
+    if (payload.size() < BINARY_PAYLOAD_SIZE) {
+        recordsMalformed++;
+        return;
+    }
+    std::uint32_t ipIn, ipOut;
+    std::int32_t time;
+    std::memcpy(&ipIn, payload.data(), 4);
+    std::memcpy(&ipOut, payload.data() + 4, 4);
+    std::memcpy(&time, payload.data() + 8, 4);
+    char jobType = payload[12];
+    if (time <= 0 || time > maxTaskTime || (jobType != 'P' && jobType != 'S')) {
+        recordsMalformed++;
+        return;
+    }
+    batch.emplace_back(ipIn, ipOut, time, jobType);
+    recordsReceived++;
+}
+
+/**
+ * @brief Accepts every client waiting on the listening socket.
+ */
+void RequestIngestor::acceptClients() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty
+        }
+        watch(fd);
+        connections.push_back({fd, std::string(), false});
+    }
+}
+
+/**
+ * @brief Stops watching and forgets a connection.
+ * @param fd The connection's file descriptor.
+ */
+void RequestIngestor::closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+    connections.erase(std::remove_if(connections.begin(), connections.end(), [fd](const Connection& c) { return c.fd == fd; }),
+                      connections.end());
+}
+
+/**
+ * @brief Gets when the oldest data behind the last batch was read.
+ * @return The read time, or time_point::max() for an empty batch.
+ */
+std::chrono::steady_clock::time_point RequestIngestor::getBatchReadAt() const {
+    return batchReadAt;
+}
+
+/**
+ * @brief Checks whether more input can arrive.
+ * @return false once stdin input has been fully consumed; always true for a socket.
+ */
+bool RequestIngestor::isOpen() const {
+    return listenFd >= 0 || !connections.empty();
+}
+
+/**
+ * @brief Sets the longest task time a record may ask for.
+ * @param cycles The limit in clock cycles.
+ */
+void RequestIngestor::setMaxTaskTime(int cycles) {
+    maxTaskTime = cycles;
+}
+
+/**
+ * @brief Gets the number of well-formed records received.
+ * @return The record count.
+ */
+long long RequestIngestor::getRecordsReceived() const {
+    return recordsReceived;
+}
+
+/**
+ * @brief Gets the number of malformed records skipped.
+ * @return The malformed record count.
+ */
+long long RequestIngestor::getRecordsMalformed() const {
+    return recordsMalformed;
+}
+
+/**
+ * @brief Gets the number of bytes read.
+ * @return The byte count.
+ */
+long long RequestIngestor::getBytesReceived() const {
+    return bytesReceived;
+}
@@ -0,0 +1,190 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include "request.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class RequestIngestor
+ * @brief Reads live requests from stdin or a Unix domain socket without blocking.
+ *
+ * All inputs are non-blocking and watched with epoll, so the balancer can keep
+ * its clock running while waiting for traffic. Two record formats are accepted:
+ *
+ * - Text: one request per line, "ipIn ipOut time jobType", e.g. "10.0.0.1 10.0.0.2 7 P".
+ * - Binary: a 2-byte length followed by that many payload bytes; the payload is
+ *   ipIn (4 bytes), ipOut (4 bytes), time (4 bytes), jobType (1 byte), all in
+ *   host byte order since producers run on the same machine.
+ *
+ * Malformed records are counted and skipped.
+ */
+class RequestIngestor {
+public:
+    /**
+     * @enum Format
+     * @brief Wire format of incoming records.
+     */
+    enum class Format {
+        Text,  /**< Newline-terminated text records */
+        Binary /**< Length-prefixed binary records */
+    };
+
+    /// Maximum number of requests returned by one call to poll()
+    static constexpr std::size_t MAX_BATCH = 4096;
+
+    /// Size of a binary record payload
+    static constexpr std::size_t BINARY_PAYLOAD_SIZE = 13;
+
+    /**
+     * @brief Constructs an ingestor reading from standard input.
+     * @param format The record format.
+     * @throws std::runtime_error if stdin cannot be watched.
+     */
+    explicit RequestIngestor(Format format);
+
+    /**
+     * @brief Constructs an ingestor listening on a Unix domain socket.
+     * Any number of clients may connect; each is read independently.
+     * @param socketPath Filesystem path of the socket; an existing socket file is replaced.
+     * @param format The record format.
+     * @throws std::runtime_error if the socket cannot be created.
+     */
+    RequestIngestor(const std::string& socketPath, Format format);
+
+    /**
+     * @brief Closes all inputs and removes the socket file.
+     */
+    ~RequestIngestor();
+
+    RequestIngestor(const RequestIngestor&) = delete;
+    RequestIngestor& operator=(const RequestIngestor&) = delete;
+
+    /**
+     * @brief Waits up to timeoutMs for input and appends the requests read to batch.
+     * @param timeoutMs Maximum time to wait in milliseconds; 0 returns immediately.
+     * @param batch Receives at most MAX_BATCH new requests.
+     * @return The number of requests appended.
+     */
+    std::size_t poll(int timeoutMs, std::vector<Request>& batch);
+
+    /**
+     * @brief Gets when the oldest data behind the last poll()'s requests was read.
+     * Records that waited in a buffer across polls keep the time they were read.
+     * @return The read time, or time_point::max() if the last poll returned nothing.
+     */
+    std::chrono::steady_clock::time_point getBatchReadAt() const;
+
+    /**
+     * @brief Checks whether more input can arrive.
+     * @return false once stdin has reached end of file and all its records have been returned.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Sets the longest task time accepted; records asking for more are malformed.
+     * @param cycles The limit in clock cycles, typically the runtime of the balancer being fed.
+     */
+    void setMaxTaskTime(int cycles);
+
+    /**
+     * @brief Gets the number of well-formed records received.
+     * @return The record count.
+     */
+    long long getRecordsReceived() const;
+
+    /**
+     * @brief Gets the number of records that were skipped as malformed.
+     * @return The malformed record count.
+     */
+    long long getRecordsMalformed() const;
+
+    /**
+     * @brief Gets the number of bytes read from all inputs.
+     * @return The byte count.
+     */
+    long long getBytesReceived() const;
+
+private:
+    /**
+     * @struct Connection
+     * @brief An open input and the bytes read from it that do not yet form a full record.
+     */
+    struct Connection {
+        int fd;             ///< The input's file descriptor
+        std::string buffer; ///< Unconsumed bytes
+        bool ended;         ///< The peer closed the input or reading failed
+        std::chrono::steady_clock::time_point readAt{}; ///< When the oldest unconsumed byte was read
+    };
+
+    /**
+     * @brief Reads what is currently available on a connection, up to a fixed amount per call.
+     * @param connection The connection to read.
+     * @return false if the peer closed the connection or it failed.
+     */
+    bool readAvailable(Connection& connection);
+
+    /**
+     * @brief Moves complete records from a connection's buffer into batch.
+     * @param connection The connection whose buffer is parsed.
+     * @param batch Receives the parsed requests.
+     * @param limit Size at which batch is full.
+     */
+    void parseRecords(Connection& connection, std::vector<Request>& batch, std::size_t limit);
+
+    /**
+     * @brief Parses one text record.
+     * @param line The record without its newline.
+     * @param batch Receives the request if the record is valid.
+     */
+    void parseTextRecord(std::string_view line, std::vector<Request>& batch);
+
+    /**
+     * @brief Parses one binary record payload.
+     * @param payload The payload bytes after the length prefix.
+     * @param batch Receives the request if the record is valid.
+     */
+    void parseBinaryRecord(std::string_view payload, std::vector<Request>& batch);
+
+    /**
+     * @brief Accepts all pending clients on the listening socket.
+     */
+    void acceptClients();
+
+    /**
+     * @brief Stops watching a connection and closes it unless it is stdin.
+     * @param fd The connection's file descriptor.
+     */
+    void closeConnection(int fd);
+
+    /**
+     * @brief Closes all inputs, the listening socket and the epoll instance, and restores stdin.
+     */
+    void closeAll();
+
+    /**
+     * @brief Adds a file descriptor to the epoll set in non-blocking mode.
+     * @param fd The file descriptor.
+     * @return false if epoll cannot watch it (regular files), in which case it is read on every poll.
+     */
+    bool watch(int fd);
+
+    Format format;                       ///< Record format of every input
+    int epollFd;                         ///< epoll instance watching all inputs
+    int listenFd;                        ///< Listening socket, or -1 when reading stdin
+    std::string socketPath;              ///< Socket file to remove on destruction
+    std::vector<Connection> connections; ///< Open inputs
+    bool readStdinDirectly;              ///< Stdin is a regular file, which epoll cannot watch
+    int stdinFlags;                      ///< Original stdin file status flags, restored on destruction
+    long long recordsReceived;           ///< Well-formed records read
+    long long recordsMalformed;          ///< Records skipped as malformed
+    int maxTaskTime;                     ///< Longest task time accepted (in clock cycles)
+    long long bytesReceived;             ///< Bytes read
+    std::chrono::steady_clock::time_point batchReadAt; ///< Oldest read time behind the last batch
+};
+
+#endif // INGEST_H
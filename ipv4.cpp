@@ -0,0 +1,164 @@
+#include "ipv4.h"
+#include <array>
+#include <bit>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h> // For classifying sixteen characters at once
+#endif
+
+/**
+ * @struct OctetText
+ * @brief Precomputed text of one octet followed by a dot.
+ */
+struct OctetText {
+    char chars[4];       /**< The digits, then '.', padded to four bytes */
+    std::uint8_t length; /**< Number of digits */
+};
+
+/**
+ * @brief Builds the text of every octet value at compile time.
+ * @return A table indexed by octet value.
+ */
+static constexpr std::array<OctetText, 256> makeOctetTable() {
+    std::array<OctetText, 256> table{};
+    for (int value = 0; value < 256; ++value) {
+        OctetText& entry = table[value];
+        int length = value >= 100 ? 3 : value >= 10 ? 2 : 1;
+        int rest = value;
+        for (int i = length - 1; i >= 0; --i) {
+            entry.chars[i] = char('0' + rest % 10);
+            rest /= 10;
+        }
+        entry.chars[length] = '.';
+        entry.length = std::uint8_t(length);
+    }
+    return table;
+}
+
+static constexpr std::array<OctetText, 256> OCTET_TABLE = makeOctetTable();
+
+/**
+ * @brief Writes an address as X.X.X.X using the octet table.
+ * @param ip The address in host byte order.
+ * @param out Buffer of at least 16 bytes.
+ * @return Characters written.
+ */
+std::size_t formatIpv4(std::uint32_t ip, char* out) {
+    char* start = out;
+    for (int shift = 24; shift > 0; shift -= 8) {
+        const OctetText& entry = OCTET_TABLE[(ip >> shift) & 0xFF];
+        std::memcpy(out, entry.chars, 4); // Digits and the trailing dot in one copy
+        out += entry.length + 1;
+    }
+    const OctetText& last = OCTET_TABLE[ip & 0xFF];
+    std::memcpy(out, last.chars, 4);
+    out += last.length;
+    return std::size_t(out - start);
+}
+
+/**
+ * @brief Formats an address as a std::string.
+ * @param ip The address in host byte order.
+ * @return The dotted-quad string.
+ */
+std::string ipv4ToString(std::uint32_t ip) {
+    char buffer[IPV4_MAX_LENGTH + 1];
+    return std::string(buffer, formatIpv4(ip, buffer));
+}
+
+/**
+ * @brief Finds the dots and digits among the first sixteen bytes of a buffer.
+ * @param buffer Sixteen readable bytes.
+ * @param dots Receives one bit per '.' character.
+ * @param digits Receives one bit per '0'-'9' character.
+ */
+static void classify(const char* buffer, std::uint32_t& dots, std::uint32_t& digits) {
+#ifdef __SSE2__
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+    dots = std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))));
+    __m128i aboveZero = _mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1));
+    __m128i belowNine = _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1));
+    digits = std::uint32_t(_mm_movemask_epi8(_mm_and_si128(aboveZero, belowNine)));
+#else
+    dots = 0;
+    digits = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (buffer[i] == '.') dots |= 1u << i;
+        else if (buffer[i] >= '0' && buffer[i] <= '9') digits |= 1u << i;
+    }
+#endif
+}
+
+/**
+ * @brief Parses strict dotted-quad text.
+ * @param text The text to parse.
+ * @param ip Receives the address on success.
+ * @return true if the text is valid.
+ */
+bool parseIpv4(std::string_view text, std::uint32_t& ip) {
+    std::size_t length = text.size();
+    if (length < 7 || length > IPV4_MAX_LENGTH) return false;
+
+    char buffer[16] = {};
+    std::memcpy(buffer, text.data(), length);
+    std::uint32_t dots, digits;
+    classify(buffer, dots, digits);
+
+    // Every character must be a digit or a dot, with exactly three dots
+    std::uint32_t inText = (1u << length) - 1;
+    if (((dots | digits) & inText) != inText || std::popcount(dots) != 3) return false;
+
+    std::uint32_t result = 0;
+    std::size_t begin = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        std::size_t end = octet < 3 ? std::size_t(std::countr_zero(dots)) : length;
+        dots &= dots - 1;
+        std::size_t width = end - begin;
+        if (width == 0 || width > 3 || (width > 1 && buffer[begin] == '0')) return false;
+
+        unsigned value = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            value = value * 10 + unsigned(buffer[i] - '0');
+        }
+        if (value > 255) return false;
+        result = (result << 8) | value;
+        begin = end + 1;
+    }
+    ip = result;
+    return true;
+}
+
+/**
+ * @brief Parses an array of addresses.
+ * @param texts The address strings.
+ * @param count Number of strings.
+ * @param out Receives the addresses, 0 for invalid entries.
+ * @return Number of valid entries.
+ */
+std::size_t parseIpv4Batch(const std::string_view* texts, std::size_t count, std::uint32_t* out) {
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t ip = 0;
+        bool ok = parseIpv4(texts[i], ip);
+        out[i] = ok ? ip : 0;
+        valid += ok;
+    }
+    return valid;
+}
+
+/**
+ * @brief Formats an array of addresses into one buffer.
+ * @param ips The addresses.
+ * @param count Number of addresses.
+ * @param out Destination buffer.
+ * @param separator Character written after each address.
+ * @return Bytes written.
+ */
+std::size_t formatIpv4Batch(const std::uint32_t* ips, std::size_t count, char* out, char separator) {
+    char* start = out;
+    for (std::size_t i = 0; i < count; ++i) {
+        out += formatIpv4(ips[i], out);
+        *out++ = separator;
+    }
+    return std::size_t(out - start);
+}
@@ -0,0 +1,63 @@
+#ifndef IPV4_H
+#define IPV4_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// Longest dotted-quad text ("255.255.255.255")
+constexpr std::size_t IPV4_MAX_LENGTH = 15;
+
+/**
+ * @brief Writes an address as dotted-quad text into a caller buffer.
+ *
+ * Each octet is copied from a precomputed table, so formatting does no
+ * division and allocates nothing. No terminator is written.
+ *
+ * @param ip The address in host byte order.
+ * @param out Buffer with room for at least IPV4_MAX_LENGTH + 1 bytes.
+ * @return The number of characters written (7 to 15).
+ */
+std::size_t formatIpv4(std::uint32_t ip, char* out);
+
+/**
+ * @brief Formats an address as a std::string.
+ * @param ip The address in host byte order.
+ * @return The address in the format X.X.X.X.
+ */
+std::string ipv4ToString(std::uint32_t ip);
+
+/**
+ * @brief Parses strict dotted-quad text.
+ *
+ * Exactly four decimal octets of 1-3 digits, each at most 255, without
+ * leading zeros, signs, spaces or trailing characters, are accepted. On x86
+ * the dots and digits are classified sixteen bytes at a time with SSE2.
+ *
+ * @param text The text to parse.
+ * @param ip Receives the address in host byte order on success.
+ * @return true if the text is a valid address.
+ */
+bool parseIpv4(std::string_view text, std::uint32_t& ip);
+
+/**
+ * @brief Parses many addresses.
+ * @param texts Array of count address strings.
+ * @param count Number of addresses.
+ * @param out Receives count addresses; invalid entries are set to 0.
+ * @return The number of entries that parsed successfully.
+ */
+std::size_t parseIpv4Batch(const std::string_view* texts, std::size_t count, std::uint32_t* out);
+
+/**
+ * @brief Formats many addresses into one buffer, each followed by separator.
+ * @param ips Array of count addresses.
+ * @param count Number of addresses.
+ * @param out Buffer with room for count * (IPV4_MAX_LENGTH + 1) + 1 bytes.
+ * @param separator Character written after each address.
+ * @return The number of bytes written.
+ */
+std::size_t formatIpv4Batch(const std::uint32_t* ips, std::size_t count, char* out, char separator = '\n');
+
+#endif // IPV4_H
@@ -0,0 +1,86 @@
+#include "ipv4.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Times a function over a number of repetitions.
+ * @param label Name printed with the result.
+ * @param items Items processed per repetition.
+ * @param repetitions Number of repetitions.
+ * @param work The code to time.
+ */
+template <typename Work>
+void timeIt(const char* label, std::size_t items, int repetitions, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        work();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << label << ": " << elapsed / (double(items) * repetitions) << " ns/address" << std::endl;
+}
+
+/**
+ * @brief Microbenchmark of the IPv4 codec against the stream and sscanf based approaches.
+ */
+int main() {
+    const std::size_t count = 1 << 16;
+    const int repetitions = 20;
+
+    std::mt19937 gen(12345);
+    std::vector<std::uint32_t> ips(count);
+    for (auto& ip : ips) {
+        ip = gen();
+    }
+
+    std::vector<std::string> texts(count);
+    std::vector<std::string_view> views(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        texts[i] = ipv4ToString(ips[i]);
+        views[i] = texts[i];
+    }
+
+    std::vector<char> buffer(count * (IPV4_MAX_LENGTH + 1) + 1);
+    std::vector<std::uint32_t> parsed(count);
+    std::size_t sink = 0;
+
+    timeIt("format (stringstream)", count, repetitions, [&] {
+        for (std::uint32_t ip : ips) {
+            std::stringstream ss;
+            ss << (ip >> 24) << "." << ((ip >> 16) & 0xFF) << "." << ((ip >> 8) & 0xFF) << "." << (ip & 0xFF);
+            sink += ss.str().size();
+        }
+    });
+    timeIt("format (ipv4ToString)", count, repetitions, [&] {
+        for (std::uint32_t ip : ips) {
+            sink += ipv4ToString(ip).size();
+        }
+    });
+    timeIt("format (formatIpv4Batch)", count, repetitions, [&] {
+        sink += formatIpv4Batch(ips.data(), count, buffer.data());
+    });
+
+    timeIt("parse (sscanf)", count, repetitions, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            unsigned a, b, c, d;
+            if (std::sscanf(texts[i].c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) == 4) {
+                parsed[i] = (a << 24) | (b << 16) | (c << 8) | d;
+            }
+        }
+    });
+    timeIt("parse (parseIpv4Batch)", count, repetitions, [&] {
+        sink += parseIpv4Batch(views.data(), count, parsed.data());
+    });
+
+    // Round trip check so the timings are of correct code
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        mismatches += parsed[i] != ips[i];
+    }
+    std::cout << "Round trip mismatches: " << mismatches << " (checksum " << sink << ")" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
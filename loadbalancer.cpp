@@ -1,11 +1,28 @@
 #include "loadbalancer.h"
+#include "ipv4.h"
 #include <iostream>
-#include <cstdlib> // For rand()
 #include <climits> // For INT_MAX and INT_MIN
-#include <ctime>   // For time()
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
-int CURRENT_CYCLE = 1;
+// Flows unseen for this many clock cycles are dropped from the flow table
+static const int FLOW_IDLE_CYCLES = 1000;
+// Flow table slots examined for expiry each clock cycle
+static const std::size_t FLOW_AGING_SLOTS = 16;
+
+// Set from signal handlers and polled once per clock cycle by every running balancer;
+// lock-free atomics are safe to update in a handler and to read from any thread.
+// Each dump request bumps the generation, and each balancer dumps once per new generation.
+static std::atomic<unsigned> flightDumpGeneration{0};
+static std::atomic<bool> abortRequested{false};
+
+// Serializes appends to output.txt and flightrecorder.txt when several balancers run at once
+static std::mutex outputMutex;
 
 /**
  * @brief Constructs a LoadBalancer object and initializes servers.
@@ -13,15 +30,58 @@ int CURRENT_CYCLE = 1;
  * @param runtime The total runtime of the simulation in clock cycles.
  */
 LoadBalancer::LoadBalancer(int numServers, int runtime) 
-    : runtime(runtime), nextServerIndex(0), requestsFinished(0), requestsRejected(0) {
+    : runtime(runtime), nextServerIndex(0), requestsFinished(0), requestsRejected(0),
+      queueDepthTrigger(numServers * 200), rejectionTrigger(10), rejectionWindow(100),
+      rejectionWindowStart(1), rejectionsInWindow(0), queueDepthTripped(false), rejectionTripped(false),
+      queueDepthTriggerSet(false), generateArrivals(true), logging(true), currentCycle(1), gen(std::random_device{}()),
+      pool(nullptr), tenant(-1), peakServers(numServers), dumpGeneration(flightDumpGeneration.load()) {
     // Initialize the list of web servers
     for (int i = 0; i < numServers; ++i) {
         servers.emplace_back(WebServer(i + 1)); // Server IDs start from 1
-        std::cout << "WebServer " << (i + 1) << " created." << std::endl;
+        busyUntil.push_back(0);
+        if constexpr (logEnabled<LOG_BALANCER>()) {
+            std::cout << "WebServer " << (i + 1) << " created." << std::endl;
+        }
     }
     requestTimes[0] = INT_MAX, requestTimes[1] = INT_MIN;
 }
 
+/**
+ * @brief Constructs a LoadBalancer that leases its servers from a shared pool.
+ * @param pool The shared server pool.
+ * @param tenant The tenant ID to lease under.
+ * @param runtime The total runtime of the simulation in clock cycles.
+ */
+LoadBalancer::LoadBalancer(ServerPool& pool, int tenant, int runtime) : LoadBalancer(0, runtime) {
+    int minServers = pool.getMinServers(tenant);
+    if (minServers < 1) {
+        throw std::invalid_argument("A pooled LoadBalancer needs a minimum of at least one server");
+    }
+    this->pool = &pool;
+    this->tenant = tenant;
+    queueDepthTrigger = minServers * 200;
+    // Tenant logs are never printed, so keeping them would only grow memory
+    logging = false;
+
+    // The tenant's minimum is reserved in the pool, so these leases always succeed
+    for (int i = 0; i < minServers && pool.lease(tenant); ++i) {
+        servers.emplace_back(WebServer(i + 1, logging));
+        busyUntil.push_back(0);
+    }
+    peakServers = servers.size();
+}
+
+/**
+ * @brief Returns every leased server to the shared pool.
+ */
+LoadBalancer::~LoadBalancer() {
+    if (pool) {
+        for (std::size_t i = 0; i < servers.size(); ++i) {
+            pool->release(tenant);
+        }
+    }
+}
+
 /**
  * @brief Adds a request to the queue and updates min/max task times.
  * @param request The request to be added.
@@ -37,21 +97,48 @@ void LoadBalancer::addRequest(const Request& request) {
  * @brief Adds a new server to the load balancer.
  */
 void LoadBalancer::addServer() {
+    if (pool && !pool->lease(tenant)) {
+        return; // At the tenant's maximum, or every shared server is leased by other tenants
+    }
     int newServerId = servers.size() + 1;
-    servers.emplace_back(WebServer(newServerId));\
-    servers[0].logMessage(CURRENT_CYCLE, "Added WebServer " + std::to_string(newServerId) + " | Total Number of Servers: " + std::to_string(servers.size()));
+    servers.emplace_back(WebServer(newServerId, logging));
+    busyUntil.push_back(0);
+    peakServers = std::max<int>(peakServers, servers.size());
+    recordEvent(FlightEventType::ServerAdded, newServerId, servers.size());
+    if constexpr (logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+        if (logging) {
+            servers[0].logMessage(currentCycle, "Added WebServer " + std::to_string(newServerId) + " | Total Number of Servers: " + std::to_string(servers.size()));
+        }
+    }
 }
 
 /**
  * @brief Removes the last server from the load balancer.
  */
 void LoadBalancer::removeServer() {
+    if (pool && int(servers.size()) <= pool->getMinServers(tenant)) {
+        return;
+    }
+    if (!busyUntil.empty() && busyUntil.back() > currentCycle) {
+        return; // A server is taken away only once its request is done
+    }
     if (!servers.empty()) {
         int serverId = servers.back().getId();
         servers.pop_back();
-        servers[0].logMessage(CURRENT_CYCLE, "Removed WebServer " + std::to_string(serverId) + " | Total Number of Servers: " + std::to_string(servers.size()));
-    } else {
-        servers[0].logMessage(CURRENT_CYCLE, "No servers to remove.");
+        busyUntil.pop_back();
+        if (pool) {
+            pool->release(tenant);
+        }
+        recordEvent(FlightEventType::ServerRemoved, serverId, servers.size());
+        if constexpr (logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+            if (logging) {
+                servers[0].logMessage(currentCycle, "Removed WebServer " + std::to_string(serverId) + " | Total Number of Servers: " + std::to_string(servers.size()));
+            }
+        }
+    } else if constexpr (logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+        if (logging) {
+            servers[0].logMessage(currentCycle, "No servers to remove.");
+        }
     }
 }
 
@@ -61,81 +148,350 @@ void LoadBalancer::removeServer() {
  * Simulates request assignment and processing using a round-robin approach.
  */
 void LoadBalancer::balanceLoad() {
-    srand((unsigned) time(0)); // Initialize random seed
-    for (; CURRENT_CYCLE <= runtime; ++CURRENT_CYCLE) {
+    // A starting backlog above the default depth trigger would dump on the first cycle
+    if (queueDepthTrigger > 0 && !queueDepthTriggerSet) {
+        queueDepthTrigger = std::max<int>(queueDepthTrigger, requestQueue.size() * 2);
+    }
+
+    for (; currentCycle <= runtime; ++currentCycle) {
+
+        // Stop early on an interrupt, keeping the last events for inspection
+        if (abortRequested) {
+            dumpFlightRecorder("Abnormal exit: simulation interrupted at clock cycle " + std::to_string(currentCycle));
+            break;
+        }
+        step();
+    }
+
+    // A finished tenant returns its shared servers so tenants still running can lease them
+    while (pool && int(servers.size()) > pool->getMinServers(tenant)) {
+        servers.pop_back();
+        busyUntil.pop_back();
+        pool->release(tenant);
+    }
+}
+
+/**
+ * @brief Runs the simulation in real time, admitting live requests in batches each cycle.
+ * @param ingestor The source of live requests.
+ * @param cycleMicros Wall-clock length of one clock cycle in microseconds.
+ */
+void LoadBalancer::balanceLoadLive(RequestIngestor& ingestor, int cycleMicros) {
+    using Clock = std::chrono::steady_clock;
+    generateArrivals = false;
+    liveStats.live = true;
+    // A task longer than the whole run can never finish, and its end cycle would overflow
+    ingestor.setMaxTaskTime(runtime);
 
-        // Dynamically add or remove servers based on requestQueue size
-        if (requestQueue.size() > servers.size() * 40) {
-            if (servers.size() < servers.size() * 2) {
-                addServer();
+    std::vector<Request> batch;
+    batch.reserve(RequestIngestor::MAX_BATCH);
+    auto start = Clock::now();
+    auto firstReadAt = Clock::time_point::max();
+    auto lastQueuedAt = start;
+    for (; currentCycle <= runtime; ++currentCycle) {
+        if (abortRequested) {
+            dumpFlightRecorder("Abnormal exit: simulation interrupted at clock cycle " + std::to_string(currentCycle));
+            break;
+        }
+
+        // Admit whatever arrives until this cycle's deadline
+        auto deadline = start + std::chrono::microseconds(static_cast<long long>(cycleMicros) * currentCycle);
+        do {
+            auto remaining = std::chrono::floor<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            batch.clear();
+            ingestor.poll(std::max<long long>(0, remaining), batch);
+            if (batch.empty()) {
+                // epoll only waits whole milliseconds, so sleep out a shorter remainder instead of spinning
+                if (remaining <= 0) {
+                    std::this_thread::sleep_until(deadline);
+                }
+                continue;
             }
-        } 
-        
-        else if(requestQueue.size() < servers.size() * 30) {
-            if (servers.size() > 1) {
-                removeServer();
+            for (const auto& request : batch) {
+                addRequest(request);
             }
+
+            // Latency runs from when the batch's oldest bytes were read, including time spent buffered
+            auto readAt = ingestor.getBatchReadAt();
+            lastQueuedAt = Clock::now();
+            firstReadAt = std::min(firstReadAt, readAt);
+            double micros = std::chrono::duration<double, std::micro>(lastQueuedAt - readAt).count();
+            liveStats.admitted += batch.size();
+            liveStats.batches++;
+            liveStats.admitMicrosTotal += micros;
+            liveStats.admitMicrosMax = std::max(liveStats.admitMicrosMax, micros);
+        } while (Clock::now() < deadline && ingestor.isOpen());
+
+        step();
+        if (Clock::now() > deadline + std::chrono::microseconds(cycleMicros)) {
+            liveStats.overrunCycles++;
         }
 
-        // Find an available server
-        WebServer* availableServer = nullptr;
+        // Input has ended and everything it sent has been dispatched
+        if (!ingestor.isOpen() && requestQueue.empty()) {
+            break;
+        }
+    }
+    if (liveStats.admitted > 0) {
+        liveStats.seconds = std::chrono::duration<double>(lastQueuedAt - firstReadAt).count();
+    }
+}
 
-        // Simple round-robin approach to assign requests to servers
-        for (int i = 0; i < int(servers.size()); ++i) {
-            int currentIndex = (nextServerIndex + i) % servers.size();
-            if (servers[currentIndex].isIdle()) {
-                availableServer = &servers[currentIndex];
-                nextServerIndex = (currentIndex + 1) % servers.size(); // Update next server index for round-robin
-                break;
-            }
+/**
+ * @brief Simulates a single clock cycle: scaling, dispatch, and random arrivals.
+ */
+void LoadBalancer::step() {
+    checkFlightRecorderTriggers();
+    flowTable.age(currentCycle, FLOW_IDLE_CYCLES, FLOW_AGING_SLOTS);
+
+    // Dynamically add or remove servers based on requestQueue size
+    if (requestQueue.size() > servers.size() * 40) {
+        if (servers.size() < servers.size() * 2) {
+            addServer();
+        }
+    } 
+    
+    else if(requestQueue.size() < servers.size() * 30) {
+        if (servers.size() > 1) {
+            removeServer();
         }
+    }
 
-        // If we found an idle server, assign the request
-        if (availableServer && !requestQueue.empty()) {
-            const Request& nextRequest = requestQueue.front();
-            availableServer->processRequest(nextRequest, CURRENT_CYCLE, runtime); // Assign request to the server
-            requestQueue.pop();
-        } 
-        // Log when no servers are available but requests are in queue
-        else if (!availableServer && !requestQueue.empty()) {
-            servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
-               ": No available servers. Requests in queue: " + std::to_string(requestQueue.size()));
+    // Servers stay busy for each request's duration, so every one of them that is free takes a request
+    if (dispatchNext()) {
+        while (dispatchNext()) {
         }
-        // Log and generate random requests when needed
-        else if (!requestQueue.empty()) {
-            int random = rand();
-
-            if(random % 2 == 0) {
-                servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
-                ": Generating and adding a random request.");
-                Request newRequest;
-                addRequest(newRequest);
+    }
+    // Log when no servers are available but requests are in queue
+    else if (!requestQueue.empty()) {
+        recordEvent(FlightEventType::NoServer, 0, servers.size());
+        if constexpr (logEnabled<LOG_BALANCER>()) {
+            if (logging) {
+                servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                   ": No available servers. Requests in queue: " + std::to_string(requestQueue.size()));
             }
-            else {
-                servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
+        }
+    }
+    // Log and generate random requests when needed
+    else if (!requestQueue.empty() && generateArrivals) {
+        unsigned random = gen();
+
+        if(random % 2 == 0) {
+            if constexpr (logEnabled<LOG_BALANCER>()) {
+                if (logging) {
+                    servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                    ": Generating and adding a random request.");
+                }
+            }
+            Request newRequest;
+            addRequest(newRequest);
+            recordEvent(FlightEventType::Generate, 0, newRequest.getTime());
+        }
+        else if constexpr (logEnabled<LOG_BALANCER>()) {
+            if (logging) {
+                servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
                 ": No random request generated.");
             }
         }
-        else if(requestQueue.empty()) {
-            servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
-               ": No requests in queue. Servers are idle.");
-            
-            int random = rand();
-
-            if(random % 2 == 0) {
-                servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
-                ": Generating and adding a random request.");
-                Request newRequest;
-                addRequest(newRequest);
+    }
+    else if(requestQueue.empty()) {
+        if constexpr (logEnabled<LOG_BALANCER>()) {
+            if (logging) {
+                servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                   ": No requests in queue. Servers are idle.");
+            }
+        }
+
+        // Live input supplies its own arrivals
+        if (!generateArrivals) {
+            return;
+        }
+
+        unsigned random = gen();
+
+        if(random % 2 == 0) {
+            if constexpr (logEnabled<LOG_BALANCER>()) {
+                if (logging) {
+                    servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                    ": Generating and adding a random request.");
+                }
             }
-            else {
-                servers[0].logMessage(CURRENT_CYCLE, "Clock cycle " + std::to_string(CURRENT_CYCLE) +
+            Request newRequest;
+            addRequest(newRequest);
+            recordEvent(FlightEventType::Generate, 0, newRequest.getTime());
+        }
+        else if constexpr (logEnabled<LOG_BALANCER>()) {
+            if (logging) {
+                servers[0].logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
                 ": No random request generated.");
             }
         }
     }
 }
 
+/**
+ * @brief Sends the request at the front of the queue to a free server.
+ * A known flow goes back to its previous server if that server is free; otherwise servers are tried round-robin.
+ * @return true if a request was dispatched, false if the queue is empty or no server is free.
+ */
+bool LoadBalancer::dispatchNext() {
+    if (requestQueue.empty()) {
+        return false;
+    }
+
+    // Find an available server
+    WebServer* availableServer = nullptr;
+
+    // Session affinity: send a known flow back to its server if that server is free
+    FlowKey flowKey = FlowKey::fromRequest(requestQueue.front());
+    Flow* knownFlow = flowTable.find(flowKey);
+    if (knownFlow && knownFlow->serverId <= int(servers.size()) && isServerFree(knownFlow->serverId - 1)) {
+        availableServer = &servers[knownFlow->serverId - 1];
+    }
+
+    // Simple round-robin approach to assign requests to servers
+    for (int i = 0; i < int(servers.size()) && !availableServer; ++i) {
+        int currentIndex = (nextServerIndex + i) % servers.size();
+        if (isServerFree(currentIndex)) {
+            availableServer = &servers[currentIndex];
+            nextServerIndex = (currentIndex + 1) % servers.size(); // Update next server index for round-robin
+            break;
+        }
+    }
+    if (!availableServer) {
+        return false;
+    }
+
+    const Request& nextRequest = requestQueue.front();
+    // Assign request to the server and count the outcome directly, so the
+    // totals stay correct even when logging is compiled out
+    if (availableServer->processRequest(nextRequest, currentCycle, runtime)) {
+        requestsFinished++;
+        // Only processed requests create or refresh a flow and pin it to the server
+        Flow& flow = flowTable.touch(flowKey, currentCycle, availableServer->getId());
+        flow.serverId = availableServer->getId();
+        flow.requests++;
+        flow.cycles += nextRequest.getTime();
+        busyUntil[availableServer->getId() - 1] = currentCycle + nextRequest.getTime();
+    } else {
+        requestsRejected++;
+        rejectionsInWindow++;
+        recordEvent(FlightEventType::Reject, availableServer->getId(), nextRequest.getTime());
+        busyUntil[availableServer->getId() - 1] = currentCycle + 1; // One attempt per server per cycle
+    }
+    requestQueue.pop();
+    return true;
+}
+
+/**
+ * @brief Checks whether a server can take a request this cycle.
+ * @param index The server's index.
+ * @return true if the server is idle and its last request has run its course.
+ */
+bool LoadBalancer::isServerFree(int index) const {
+    return servers[index].isIdle() && busyUntil[index] <= currentCycle;
+}
+
+/**
+ * @brief Sets the thresholds that make the flight recorders dump automatically.
+ * @param queueDepth Queue depth that triggers a dump (0 disables, negative keeps the current value).
+ * @param rejections Rejections per window that trigger a dump (0 disables, negative keeps the current value).
+ * @param window Length of the rejection window in clock cycles (0 or negative keeps the current value).
+ */
+void LoadBalancer::setFlightRecorderTriggers(int queueDepth, int rejections, int window) {
+    if (queueDepth >= 0) {
+        queueDepthTrigger = queueDepth;
+        queueDepthTriggerSet = true;
+    }
+    if (rejections >= 0) {
+        rejectionTrigger = rejections;
+    }
+    if (window > 0) {
+        rejectionWindow = window;
+    }
+}
+
+/**
+ * @brief Dumps the balancer's and all servers' flight recorders to flightrecorder.txt.
+ * @param reason The heading written above the dump.
+ */
+void LoadBalancer::dumpFlightRecorder(const std::string& reason) {
+    std::string heading = pool ? "Tenant " + std::to_string(tenant) + ": " + reason : reason;
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::ofstream dumpFile("flightrecorder.txt", std::ios::app);
+    dumpFile << "=======================================================" << std::endl;
+    dumpFile << heading << std::endl;
+    dumpFile << "=======================================================" << std::endl;
+    flightRecorder.dump(dumpFile, "LoadBalancer");
+    for (const auto& server : servers) {
+        server.getFlightRecorder().dump(dumpFile, "WebServer " + std::to_string(server.getId()));
+    }
+    dumpFile.close();
+
+    if constexpr (logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+        std::cout << "Flight recorder dumped to flightrecorder.txt: " << heading << std::endl;
+    }
+}
+
+/**
+ * @brief Asks every running balancer for a flight recorder dump; polled by balanceLoad().
+ */
+void LoadBalancer::requestFlightRecorderDump() {
+    flightDumpGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Marks the simulation as interrupted; balanceLoad() dumps and stops.
+ */
+void LoadBalancer::requestAbort() {
+    abortRequested.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Dumps the flight recorders when a user request or an overload condition is seen.
+ */
+void LoadBalancer::checkFlightRecorderTriggers() {
+    unsigned generation = flightDumpGeneration.load(std::memory_order_relaxed);
+    if (generation != dumpGeneration) {
+        dumpGeneration = generation;
+        dumpFlightRecorder("User requested dump at clock cycle " + std::to_string(currentCycle));
+    }
+
+    // Queue depth: fire once when exceeded, re-arm once the queue drops back below
+    int queueSize = requestQueue.size();
+    if (queueDepthTrigger > 0 && queueSize > queueDepthTrigger) {
+        if (!queueDepthTripped) {
+            queueDepthTripped = true;
+            dumpFlightRecorder("Queue depth " + std::to_string(queueSize) + " exceeded " +
+                               std::to_string(queueDepthTrigger) + " at clock cycle " + std::to_string(currentCycle));
+        }
+    } else {
+        queueDepthTripped = false;
+    }
+
+    // Rejection spike: fire at most once per window
+    if (currentCycle - rejectionWindowStart >= rejectionWindow) {
+        rejectionWindowStart = currentCycle;
+        rejectionsInWindow = 0;
+        rejectionTripped = false;
+    }
+    if (rejectionTrigger > 0 && rejectionsInWindow >= rejectionTrigger && !rejectionTripped) {
+        rejectionTripped = true;
+        dumpFlightRecorder(std::to_string(rejectionsInWindow) + " rejections within " +
+                           std::to_string(rejectionWindow) + " clock cycles at clock cycle " + std::to_string(currentCycle));
+    }
+}
+
+/**
+ * @brief Records a balancer event with the current cycle and queue depth.
+ * @param type The kind of event.
+ * @param serverId The server involved, or 0 if none.
+ * @param value Event specific value.
+ */
+void LoadBalancer::recordEvent(FlightEventType type, int serverId, int value) {
+    flightRecorder.record({currentCycle, type, serverId, static_cast<int>(requestQueue.size()), value});
+}
+
 /**
  * @brief Generates a specified number of random requests and adds them to the queue.
  * @param numRequests The number of random requests to generate.
@@ -185,6 +541,10 @@ int LoadBalancer::getRequestsFinished() const {
  * @brief Prints the log entries of all servers to the console and to an output file.
  */
 void LoadBalancer::printLogEntries() {
+    if constexpr (LOG_LEVEL == LogLevel::Off) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(outputMutex);
     std::ofstream logFile("output.txt", std::ios::app);
     std::vector<LogEntry> allLogEntries;
     for (const auto& server : servers) {
@@ -204,16 +564,6 @@ void LoadBalancer::printLogEntries() {
             logFile << entry.message << std::endl;
             std::cout << "-------------------------------------------------------" << std::endl;
             logFile << "-------------------------------------------------------" << std::endl;
-            if(entry.message.find("finished processing request") != std::string::npos) {
-                requestsFinished++;
-            }
-            else if(entry.message.find("cannot be processed within the time duration") != std::string::npos) {
-                requestsRejected++;
-            }
-        }
-        // Beyond the runtime, discard the requests
-        else {
-            requestsRejected++;
         }
     }
     logFile.close();
@@ -224,6 +574,10 @@ void LoadBalancer::printLogEntries() {
  * @param timeDuration The total simulation duration in clock cycles.
  */
 void LoadBalancer::printStartStatus(int timeDuration) {
+    if constexpr (!logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(outputMutex);
     std::ofstream logFile("output.txt", std::ios::app);
     std::cout << "-------------------------------------------------------" << std::endl;
     logFile << "-------------------------------------------------------" << std::endl;
@@ -244,11 +598,12 @@ void LoadBalancer::printStartStatus(int timeDuration) {
  * @brief Prints the final status of the LoadBalancer including server statuses and queue size.
  */
 void LoadBalancer::printEndStatus() {
+    std::lock_guard<std::mutex> lock(outputMutex);
     std::ofstream logFile("output.txt", std::ios::app);
     int activeServers = 0;
     int inactiveServers = 0;
-    for (const auto& server : servers) {
-        if (server.isIdle()) {
+    for (int i = 0; i < int(servers.size()); ++i) {
+        if (isServerFree(i)) {
             inactiveServers++;
         } else {
             activeServers++;
@@ -267,6 +622,34 @@ void LoadBalancer::printEndStatus() {
     logFile << "Requests processed: " << requestsFinished << std::endl;
     std::cout << "Requests rejected/discarded: " << requestsRejected << std::endl;
     logFile << "Requests rejected/discarded: " << requestsRejected << std::endl;
+    std::cout << "Tracked flows: " << flowTable.size() << " | Expired: " << flowTable.getFlowsExpired() << std::endl;
+    logFile << "Tracked flows: " << flowTable.size() << " | Expired: " << flowTable.getFlowsExpired() << std::endl;
+    if (pool) {
+        std::string line = "Tenant " + std::to_string(tenant) + " servers leased: " + std::to_string(pool->getLeased(tenant)) +
+                           " | Peak: " + std::to_string(peakServers) + " (min " + std::to_string(pool->getMinServers(tenant)) + ", max " + std::to_string(pool->getMaxServers(tenant)) +
+                           ") | Leases denied: " + std::to_string(pool->getDenied(tenant));
+        std::cout << line << std::endl;
+        logFile << line << std::endl;
+    }
+    if (liveStats.live) {
+        double throughput = liveStats.seconds > 0 ? liveStats.admitted / liveStats.seconds : 0;
+        double meanMicros = liveStats.batches > 0 ? liveStats.admitMicrosTotal / liveStats.batches : 0;
+        std::string line = "Live ingest: " + std::to_string(liveStats.admitted) + " requests in " +
+                           std::to_string(liveStats.batches) + " batches | " + std::to_string(throughput) +
+                           " requests/s | Read-to-queue latency mean/max: " + std::to_string(meanMicros) + "/" +
+                           std::to_string(liveStats.admitMicrosMax) + " us | Overrun cycles: " +
+                           std::to_string(liveStats.overrunCycles);
+        std::cout << line << std::endl;
+        logFile << line << std::endl;
+    }
+    for (const auto& flow : flowTable.topFlows(5)) {
+        std::string line = "  " + ipv4ToString(flow.key.ipIn) + " -> " + ipv4ToString(flow.key.ipOut) +
+                           " | Server: " + std::to_string(flow.serverId) +
+                           " | Requests: " + std::to_string(flow.requests) +
+                           " | Cycles: " + std::to_string(flow.cycles);
+        std::cout << line << std::endl;
+        logFile << line << std::endl;
+    }
     std::cout << "-------------------------------------------------------" << std::endl;
     logFile << "-------------------------------------------------------" << std::endl;
     logFile.close();
@@ -3,13 +3,36 @@
 
 #include "request.h"
 #include "webserver.h"
+#include "flightrecorder.h"
+#include "flowtable.h"
+#include "ingest.h"
+#include "serverpool.h"
 #include <queue>
 #include <vector>
 #include <random>
 
+/**
+ * @struct LiveStats
+ * @brief Measurements taken while running against live input.
+ */
+struct LiveStats {
+    bool live = false;               ///< A live run took place
+    long long admitted = 0;          ///< Requests admitted to the queue
+    long long batches = 0;           ///< Non-empty batches admitted
+    long long overrunCycles = 0;     ///< Cycles still running when the next cycle was due
+    double admitMicrosTotal = 0;     ///< Sum over batches of the time from reading the oldest record to queueing (microseconds)
+    double admitMicrosMax = 0;       ///< Largest such time of a batch (microseconds)
+    double seconds = 0;              ///< Wall-clock time from the first request read to the last one queued
+};
+
 /**
  * @class LoadBalancer
  * @brief Simulates a load balancer that distributes incoming requests to multiple web servers.
+ *
+ * A server that takes a request stays busy for the request's task time, and every
+ * free server takes a request each cycle, whether the servers are private or leased
+ * from a shared pool. Pooled balancers keep no message log, since tenant logs are
+ * not printed; their flight recorders still run.
  */
 class LoadBalancer {
 public:
@@ -20,6 +43,25 @@ public:
      */
     LoadBalancer(int numServers, int runtime);
 
+    /**
+     * @brief Constructs a LoadBalancer whose servers are leased from a shared pool.
+     * Starts with the tenant's minimum number of servers; addServer() and removeServer()
+     * then lease from and return to the pool, within the tenant's quotas.
+     * @param pool The shared server pool.
+     * @param tenant The tenant ID this balancer leases under; its minimum must be at least 1.
+     * @param runtime The total runtime (in clock cycles) of the load balancer.
+     * @throws std::invalid_argument if the tenant's minimum is below 1.
+     */
+    LoadBalancer(ServerPool& pool, int tenant, int runtime);
+
+    /**
+     * @brief Returns any leased servers to the pool.
+     */
+    ~LoadBalancer();
+
+    LoadBalancer(const LoadBalancer&) = delete;
+    LoadBalancer& operator=(const LoadBalancer&) = delete;
+
     /**
      * @brief Adds a request to the load balancer's request queue.
      * @param request The request to be added to the queue.
@@ -28,20 +70,43 @@ public:
 
     /**
      * @brief Adds a new server to the load balancer.
+     * With a shared pool, the server is only added if the pool grants a lease.
      */
     void addServer();
 
     /**
      * @brief Removes the last server from the load balancer.
+     * A busy server is kept until its request is done. With a shared pool, the server is
+     * returned to it, but never below the tenant's minimum.
      */
     void removeServer();
 
     /**
      * @brief Balances the load by distributing requests to the available servers.
-     * Uses a round-robin approach to assign requests to servers.
+     * Requests of a tracked flow go back to the flow's server when it is idle;
+     * otherwise a round-robin approach is used to assign requests to servers.
+     * Every free server takes a request each cycle. Pooled balancers return servers
+     * above their minimum to the pool when the run ends.
      */
     void balanceLoad();
 
+    /**
+     * @brief Runs the load balancer in real time against live input.
+     * Each clock cycle lasts cycleMicros of wall-clock time; requests read from the
+     * ingestor during a cycle are admitted to the queue in batches before the cycle
+     * is simulated. No random requests are generated. The run ends after the runtime
+     * or once the input has ended and the queue is empty. Records whose task time
+     * exceeds the runtime are counted as malformed.
+     * @param ingestor The source of live requests.
+     * @param cycleMicros Wall-clock length of one clock cycle in microseconds.
+     */
+    void balanceLoadLive(RequestIngestor& ingestor, int cycleMicros);
+
+    /**
+     * @brief Simulates the current clock cycle.
+     */
+    void step();
+
     /**
      * @brief Generates a specified number of random requests.
      * @param numRequests The number of random requests to generate.
@@ -90,14 +155,89 @@ public:
      */
     void printEndStatus();
 
+    /**
+     * @brief Configures when the flight recorders are dumped automatically.
+     * A value of 0 disables the corresponding trigger; a negative value keeps its current setting.
+     * Without an explicit queue depth, balanceLoad() raises the default to twice the starting backlog.
+     * @param queueDepth Dump when the request queue grows beyond this many requests.
+     * @param rejections Dump when this many requests are rejected within one window.
+     * @param window Length of the rejection window (in clock cycles).
+     */
+    void setFlightRecorderTriggers(int queueDepth, int rejections, int window);
+
+    /**
+     * @brief Writes the balancer's and every server's recent events to flightrecorder.txt.
+     * @param reason Why the dump was taken; written as the dump heading.
+     */
+    void dumpFlightRecorder(const std::string& reason);
+
+    /**
+     * @brief Asks every running balancer to dump its flight recorders at its next cycle.
+     * Safe to call from a signal handler.
+     */
+    static void requestFlightRecorderDump();
+
+    /**
+     * @brief Asks the running simulation to dump its flight recorders and stop early.
+     * Safe to call from a signal handler.
+     */
+    static void requestAbort();
+
 private:
+    /**
+     * @brief Dispatches the request at the front of the queue to a free server, if there is one.
+     * @return true if a request was dispatched.
+     */
+    bool dispatchNext();
+
+    /**
+     * @brief Checks whether a server can take a request in the current cycle.
+     * @param index Index of the server.
+     * @return true if the server is free.
+     */
+    bool isServerFree(int index) const;
+
+    /**
+     * @brief Checks the automatic dump conditions for the current cycle.
+     * Each trigger dumps once when it trips and re-arms after the condition clears.
+     */
+    void checkFlightRecorderTriggers();
+
+    /**
+     * @brief Records a balancer-wide event in the balancer's flight recorder.
+     * @param type The kind of event.
+     * @param serverId The server involved, or 0 if none.
+     * @param value Event specific value.
+     */
+    void recordEvent(FlightEventType type, int serverId, int value);
+
     std::queue<Request> requestQueue;     ///< Queue to hold incoming requests
     std::vector<WebServer> servers;       ///< Vector to hold the web servers
+    std::vector<int> busyUntil;           ///< Cycle at which each server is free again
     int runtime;                          ///< Total runtime of the load balancer
     int nextServerIndex;                  ///< Tracks which server gets the next request (round-robin)
     int requestTimes[2];                  ///< Range for request times (min, max)
     int requestsFinished;                 ///< Number of requests that have been successfully processed
     int requestsRejected;                 ///< Number of requests that were rejected or discarded
+    FlightRecorder<1024> flightRecorder;  ///< Always-on record of the balancer's most recent events
+    int queueDepthTrigger;                ///< Queue depth that triggers a dump (0 = disabled)
+    int rejectionTrigger;                 ///< Rejections per window that trigger a dump (0 = disabled)
+    int rejectionWindow;                  ///< Length of the rejection window in clock cycles
+    int rejectionWindowStart;             ///< Cycle at which the current rejection window began
+    int rejectionsInWindow;               ///< Rejections counted in the current window
+    bool queueDepthTripped;               ///< Queue depth trigger has fired and not yet cleared
+    bool rejectionTripped;                ///< Rejection trigger has fired in the current window
+    bool queueDepthTriggerSet;            ///< Queue depth trigger was configured explicitly
+    FlowTable flowTable;                  ///< Connection tracking for session affinity
+    bool generateArrivals;                ///< Whether step() adds random requests (off for live input)
+    bool logging;                         ///< Whether balancer and server messages are kept (off when pooled)
+    LiveStats liveStats;                  ///< Ingest measurements of a live run
+    int currentCycle;                     ///< The clock cycle being simulated
+    std::mt19937 gen;                     ///< Random engine for request arrivals
+    ServerPool* pool;                     ///< Shared server pool, or nullptr if the servers are private
+    int tenant;                           ///< Tenant ID in the shared pool
+    int peakServers;                      ///< Most servers held at once
+    unsigned dumpGeneration;              ///< Last dump request generation this balancer has served
 };
 
 #endif // LOADBALANCER_H
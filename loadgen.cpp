@@ -0,0 +1,139 @@
+#include "ipv4.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Writes a whole buffer to a file descriptor.
+ * @param fd The destination.
+ * @param data The bytes to write.
+ * @return false if the write failed, e.g. because the reader went away.
+ */
+bool writeAll(int fd, const string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = write(fd, data.data() + written, data.size() - written);
+        if (count <= 0) {
+            return false;
+        }
+        written += count;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends one request record to a buffer in the ingest wire format.
+ * @param out The buffer.
+ * @param binary Whether to use the binary format instead of text.
+ * @param ipIn Source address.
+ * @param ipOut Destination address.
+ * @param time Processing time in clock cycles.
+ * @param jobType 'P' or 'S'.
+ */
+void appendRecord(string& out, bool binary, uint32_t ipIn, uint32_t ipOut, int32_t time, char jobType) {
+    if (binary) {
+        char record[2 + 13];
+        uint16_t length = 13;
+        memcpy(record, &length, 2);
+        memcpy(record + 2, &ipIn, 4);
+        memcpy(record + 6, &ipOut, 4);
+        memcpy(record + 10, &time, 4);
+        record[14] = jobType;
+        out.append(record, sizeof(record));
+        return;
+    }
+    char text[2 * IPV4_MAX_LENGTH + 16];
+    size_t length = formatIpv4(ipIn, text);
+    text[length++] = ' ';
+    length += formatIpv4(ipOut, text + length);
+    out.append(text, length);
+    out += ' ' + to_string(time) + ' ' + jobType + '\n';
+}
+
+/**
+ * @brief Small load generator for the balancer's live ingest mode.
+ *
+ * Writes random requests, drawn from a fixed set of flows, to stdout or to a
+ * Unix domain socket. Options: --socket PATH, --format text|binary,
+ * --count N requests, --rate R requests per second (0 = unthrottled),
+ * --flows F distinct (ipIn, ipOut) pairs and --seed S.
+ */
+int main(int argc, char* argv[]) {
+    string socketPath;
+    bool binary = false;
+    long long count = 100000;
+    long long rate = 0;
+    int flows = 1000;
+    unsigned seed = 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--socket") == 0) socketPath = argv[i + 1];
+        else if (strcmp(argv[i], "--format") == 0) binary = strcmp(argv[i + 1], "binary") == 0;
+        else if (strcmp(argv[i], "--count") == 0) count = stoll(argv[i + 1]);
+        else if (strcmp(argv[i], "--rate") == 0) rate = stoll(argv[i + 1]);
+        else if (strcmp(argv[i], "--flows") == 0) flows = max(1, stoi(argv[i + 1]));
+        else if (strcmp(argv[i], "--seed") == 0) seed = stoul(argv[i + 1]);
+    }
+
+    signal(SIGPIPE, SIG_IGN); // Report a closed reader as a write error instead of dying
+
+    int fd = STDOUT_FILENO;
+    if (!socketPath.empty()) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            cerr << "Cannot connect to " << socketPath << ": " << strerror(errno) << endl;
+            return 1;
+        }
+    }
+
+    mt19937 gen(seed);
+    vector<pair<uint32_t, uint32_t>> flowSet(flows);
+    for (auto& flow : flowSet) {
+        flow = {uint32_t(gen()), uint32_t(gen())};
+    }
+    uniform_int_distribution<int> pickFlow(0, flows - 1);
+    uniform_int_distribution<int> pickTime(1, 20);
+
+    // Send in slices of 1 ms worth of records when throttled, otherwise in large chunks
+    const long long sliceSize = rate > 0 ? max(1LL, rate / 1000) : 4096;
+    auto start = chrono::steady_clock::now();
+    string buffer;
+    long long sent = 0;
+    while (sent < count) {
+        buffer.clear();
+        long long slice = min(sliceSize, count - sent);
+        for (long long i = 0; i < slice; ++i) {
+            const auto& flow = flowSet[pickFlow(gen)];
+            appendRecord(buffer, binary, flow.first, flow.second, pickTime(gen), gen() % 2 ? 'P' : 'S');
+        }
+        if (!writeAll(fd, buffer)) {
+            cerr << "Write failed after " << sent << " requests: " << strerror(errno) << endl;
+            break;
+        }
+        sent += slice;
+        if (rate > 0) {
+            this_thread::sleep_until(start + chrono::microseconds(sent * 1000000 / rate));
+        }
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cerr << "Sent " << sent << " requests in " << seconds << " s (" << (seconds > 0 ? sent / seconds : 0) << " requests/s)" << endl;
+    if (fd != STDOUT_FILENO) {
+        close(fd);
+    }
+    return sent == count ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#ifndef LOGCONFIG_H
+#define LOGCONFIG_H
+
+/**
+ * @file logconfig.h
+ * @brief Compile-time logging configuration for the load balancer simulation.
+ *
+ * The log level and subsystem mask are fixed when the program is built
+ * (see the Makefile variants). Every logging call site is wrapped in
+ * `if constexpr (logEnabled<...>())`, so disabled messages are never built
+ * and cost nothing at runtime. Request counters are kept regardless of level.
+ */
+
+// Level selected at build time: 0 = off, 1 = summary, 2 = full
+#ifndef LB_LOG_LEVEL
+#define LB_LOG_LEVEL 2
+#endif
+
+// Bitmask of subsystems allowed to log (see LogSubsystem)
+#ifndef LB_LOG_MASK
+#define LB_LOG_MASK 0xFF
+#endif
+
+/**
+ * @enum LogLevel
+ * @brief Verbosity of the simulation output.
+ */
+enum class LogLevel {
+    Off = 0,     /**< No log entries and no start report; only the final counters are printed */
+    Summary = 1, /**< Start/end reports and rare events such as server scaling */
+    Full = 2     /**< Every per-cycle and per-request event */
+};
+
+/**
+ * @enum LogSubsystem
+ * @brief Bit flags identifying which part of the simulation emits a message.
+ */
+enum LogSubsystem : unsigned {
+    LOG_BALANCER = 1u << 0, /**< Messages produced by the LoadBalancer */
+    LOG_SERVER = 1u << 1    /**< Messages produced by a WebServer */
+};
+
+constexpr LogLevel LOG_LEVEL = static_cast<LogLevel>(LB_LOG_LEVEL); ///< Level this binary was built with
+constexpr unsigned LOG_MASK = LB_LOG_MASK;                          ///< Subsystems this binary logs for
+
+/**
+ * @brief Checks at compile time whether a message should be logged.
+ *
+ * @tparam Subsystem The subsystem emitting the message.
+ * @tparam Level The minimum level at which the message is emitted.
+ * @return true if the build's level and mask allow the message.
+ */
+template <unsigned Subsystem, LogLevel Level = LogLevel::Full>
+constexpr bool logEnabled() {
+    return (LOG_MASK & Subsystem) != 0 && static_cast<int>(LOG_LEVEL) >= static_cast<int>(Level);
+}
+
+#endif // LOGCONFIG_H
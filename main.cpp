@@ -2,23 +2,236 @@
 #include "request.h"
 #include "webserver.h"
 #include "loadbalancer.h"
+#include "shardedloadbalancer.h"
+#include "ingest.h"
+#include "serverpool.h"
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
-int main() {
+/**
+ * @brief Signal handler: SIGUSR1 dumps the flight recorders, SIGINT/SIGTERM also stop the run.
+ * @param signal The signal received.
+ */
+void handleSignal(int signal) {
+    if (signal == SIGUSR1) {
+        LoadBalancer::requestFlightRecorderDump();
+    } else {
+        LoadBalancer::requestAbort();
+        ShardedLoadBalancer::requestAbort();
+    }
+}
+
+/**
+ * @brief Parses a whole option value as an int.
+ * @param text The value.
+ * @return The number.
+ * @throws std::invalid_argument if text is not entirely a number.
+ * @throws std::out_of_range if the number does not fit in an int.
+ */
+int parseInt(const char* text) {
+    size_t used = 0;
+    int value = stoi(text, &used);
+    if (text[used] != '\0') throw invalid_argument(text);
+    return value;
+}
+
+/**
+ * @brief Parses a whole option value as an unsigned int.
+ * @param text The value.
+ * @return The number.
+ * @throws std::invalid_argument if text is not entirely a non-negative number.
+ * @throws std::out_of_range if the number does not fit in an unsigned int.
+ */
+unsigned parseUnsigned(const char* text) {
+    size_t used = 0;
+    long long value = stoll(text, &used);
+    if (text[used] != '\0' || value < 0) throw invalid_argument(text);
+    if (value > numeric_limits<unsigned>::max()) throw out_of_range(text);
+    return unsigned(value);
+}
+
+/**
+ * @brief Parses a whole option value as a double.
+ * @param text The value.
+ * @return The number.
+ * @throws std::invalid_argument if text is not entirely a number.
+ * @throws std::out_of_range if the number does not fit in a double.
+ */
+double parseDouble(const char* text) {
+    size_t used = 0;
+    double value = stod(text, &used);
+    if (text[used] != '\0') throw invalid_argument(text);
+    return value;
+}
+
+/**
+ * @brief Runs the load balancer simulation.
+ * 
+ * Options: --shards N runs the sharded parallel simulation with N shards,
+ * --threads T sets its worker threads, --seed S its seed and --epoch E the
+ * clock cycles between shard barriers; --arrival-rate P sets the probability
+ * that a shard server receives a new request in a cycle. --ingest stdin|PATH runs in real time on
+ * live requests from stdin or a Unix domain socket, with --format text|binary
+ * and --cycle-us U microseconds per clock cycle. --tenants K runs K load
+ * balancers on separate threads sharing one pool of the given number of
+ * servers. --dump-queue D, --dump-rejections R and --dump-window W set when
+ * the flight recorders dump automatically (0 disables a trigger). --servers N
+ * and --cycles C skip the interactive prompts; both are required with
+ * --ingest stdin.
+ */
+int main(int argc, char* argv[]) {
     
-    int numServers;
-    int timeDuration;
+    int numServers = 0;
+    int timeDuration = 0;
+    int numShards = 0;
+    int numThreads = 1;
+    unsigned seed = 1;
+    int epochLength = 10;
+    double arrivalRate = 0.05;
+    string ingestSource;
+    RequestIngestor::Format ingestFormat = RequestIngestor::Format::Text;
+    int cycleMicros = 1000;
+    int numTenants = 0;
+    int dumpQueue = -1;      // Negative keeps the balancer's default
+    int dumpRejections = -1;
+    int dumpWindow = 0;
+
+    int i = 1;
+    try {
+        for (; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--shards") == 0) numShards = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--threads") == 0) numThreads = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--seed") == 0) seed = parseUnsigned(argv[i + 1]);
+            else if (strcmp(argv[i], "--epoch") == 0) epochLength = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--arrival-rate") == 0) arrivalRate = parseDouble(argv[i + 1]);
+            else if (strcmp(argv[i], "--ingest") == 0) ingestSource = argv[i + 1];
+            else if (strcmp(argv[i], "--format") == 0 && strcmp(argv[i + 1], "binary") == 0) ingestFormat = RequestIngestor::Format::Binary;
+            else if (strcmp(argv[i], "--cycle-us") == 0) cycleMicros = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--tenants") == 0) numTenants = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--servers") == 0) numServers = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--cycles") == 0) timeDuration = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--dump-queue") == 0) dumpQueue = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--dump-rejections") == 0) dumpRejections = parseInt(argv[i + 1]);
+            else if (strcmp(argv[i], "--dump-window") == 0) dumpWindow = parseInt(argv[i + 1]);
+        }
+    } catch (const invalid_argument&) {
+        cerr << argv[i] << ": not a number: " << argv[i + 1] << endl;
+        return 1;
+    } catch (const out_of_range&) {
+        cerr << argv[i] << ": out of range: " << argv[i + 1] << endl;
+        return 1;
+    }
+
+    if (cycleMicros <= 0) {
+        cerr << "--cycle-us must be positive" << endl;
+        return 1;
+    }
+
+    // Stdin carries the requests in this mode, so it cannot also answer the prompts
+    if (ingestSource == "stdin" && (numServers <= 0 || timeDuration <= 0)) {
+        cerr << "--ingest stdin requires --servers and --cycles" << endl;
+        return 1;
+    }
+
+    if (numServers <= 0) {
+        cout << "Enter number of servers: ";
+        cin >> numServers;
+    }
+
+    if (timeDuration <= 0) {
+        cout << "Enter loadbalancer time duration (clock cycles): ";
+        cin >> timeDuration;
+    }
+
+    if (numServers <= 0 || timeDuration <= 0) {
+        cerr << "The number of servers and the duration must be positive" << endl;
+        return 1;
+    }
+
+    signal(SIGUSR1, handleSignal);
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    if (numShards > 0) {
+        ShardedLoadBalancer shardedBalancer(numServers, timeDuration, numShards, seed, epochLength, arrivalRate);
+        shardedBalancer.generateRandomRequests(100);
+
+        shardedBalancer.printStartStatus();
+        shardedBalancer.balanceLoad(numThreads);
+        shardedBalancer.printEndStatus();
+        return 0;
+    }
+
+    if (!ingestSource.empty()) {
+        unique_ptr<RequestIngestor> ingestor;
+        try {
+            if (ingestSource == "stdin") {
+                ingestor = make_unique<RequestIngestor>(ingestFormat);
+            } else {
+                ingestor = make_unique<RequestIngestor>(ingestSource, ingestFormat);
+            }
+        } catch (const runtime_error& error) {
+            cerr << "Cannot open live input: " << error.what() << endl;
+            return 1;
+        }
+
+        LoadBalancer loadBalancer(numServers, timeDuration);
+        loadBalancer.setFlightRecorderTriggers(dumpQueue, dumpRejections, dumpWindow);
+        loadBalancer.printStartStatus(timeDuration);
+        loadBalancer.balanceLoadLive(*ingestor, cycleMicros);
+        loadBalancer.printLogEntries();
+        loadBalancer.printEndStatus();
+        cout << "Records received: " << ingestor->getRecordsReceived()
+             << " | Malformed: " << ingestor->getRecordsMalformed()
+             << " | Bytes: " << ingestor->getBytesReceived() << endl;
+        return 0;
+    }
+
+    if (numTenants > 0) {
+        // Each tenant is guaranteed an equal share of half the fleet; the other half moves to whoever needs it
+        ServerPool pool(numServers);
+        int minServers = max(1, numServers / (2 * numTenants));
+        vector<unique_ptr<LoadBalancer>> balancers;
+        try {
+            for (int t = 0; t < numTenants; ++t) {
+                int tenant = pool.addTenant(minServers, numServers - minServers * (numTenants - 1));
+                balancers.push_back(make_unique<LoadBalancer>(pool, tenant, timeDuration));
+                balancers.back()->setFlightRecorderTriggers(dumpQueue, dumpRejections, dumpWindow);
+                // Uneven starting backlogs so capacity has a reason to move
+                balancers.back()->generateRandomRequests(minServers * 100 * (t + 1));
+            }
+        } catch (const invalid_argument& error) {
+            cerr << "Cannot create tenants: " << error.what() << endl;
+            return 1;
+        }
 
-    cout << "Enter number of servers: ";
-    cin >> numServers;
+        vector<thread> threads;
+        for (auto& balancer : balancers) {
+            threads.emplace_back([&balancer] { balancer->balanceLoad(); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
 
-    cout << "Enter loadbalancer time duration (clock cycles): ";
-    cin >> timeDuration;
+        for (auto& balancer : balancers) {
+            balancer->printEndStatus();
+        }
+        cout << "Shared servers free: " << pool.getSharedFree() << " of fleet " << pool.getFleetSize() << endl;
+        return 0;
+    }
 
 	//start the load balancer
 
     LoadBalancer loadBalancer(numServers, timeDuration);
+    loadBalancer.setFlightRecorderTriggers(dumpQueue, dumpRejections, dumpWindow);
     loadBalancer.generateRandomRequests(numServers * 100);
 
     loadBalancer.printStartStatus(timeDuration);
@@ -1,33 +1,31 @@
 #include "request.h"
+#include "ipv4.h"
 #include <random>
-#include <sstream>
 #include <iostream>
 
 // Helper function to generate a random IP address
 /**
  * @brief Generates a random IPv4 address.
  * 
- * This function generates a random IPv4 address in the format X.X.X.X,
- * where each X is a random integer between 0 and 255.
+ * This function draws a random 32-bit address; it is rendered in the format
+ * X.X.X.X, where each X is an integer between 0 and 255, when the request is built.
  * 
- * @return A string representing the randomly generated IPv4 address.
- */
-std::string generateRandomIp() {
-    std::random_device rd;  // Seed generator
-    std::mt19937 gen(rd()); // Mersenne Twister engine
-    std::uniform_int_distribution<> dist(0, 255); // Range for octets
-
-    // Generate four random octets
-    int octet1 = dist(gen);
-    int octet2 = dist(gen);
-    int octet3 = dist(gen);
-    int octet4 = dist(gen);
-
-    // Convert the octets to a string in the format X.X.X.X
-    std::stringstream ss;
-    ss << octet1 << "." << octet2 << "." << octet3 << "." << octet4;
-    
-    return ss.str();
+ * @param gen The random engine to draw the address from.
+ * @return The randomly generated IPv4 address in host byte order.
+ */
+std::uint32_t generateRandomIp(std::mt19937& gen) {
+    return std::uint32_t(gen());
+}
+
+/**
+ * @brief Parses a dotted-quad address, mapping malformed input to 0.
+ * 
+ * @param text The address.
+ * @return The address in host byte order, or 0.
+ */
+static std::uint32_t addressOf(const std::string& text) {
+    std::uint32_t address = 0;
+    return parseIpv4(text, address) ? address : 0;
 }
 
 /**
@@ -36,11 +34,10 @@ std::string generateRandomIp() {
  * This function generates a random integer between 1 and 20 (inclusive)
  * to represent the processing time required for a request.
  * 
+ * @param gen The random engine to draw from.
  * @return A randomly generated integer representing the processing time.
  */
-int generateRandomTime() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+int generateRandomTime(std::mt19937& gen) {
     std::uniform_int_distribution<> dist(1, 20); // Example range for time
     return dist(gen);
 }
@@ -50,15 +47,27 @@ int generateRandomTime() {
  * 
  * This function randomly selects between two job types: 'P' (Processing) or 'S' (Streaming).
  * 
+ * @param gen The random engine to draw from.
  * @return A randomly chosen character representing the job type ('P' or 'S').
  */
-char generateRandomJobType() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+char generateRandomJobType(std::mt19937& gen) {
     std::uniform_int_distribution<> dist(0, 1); // Range for two job types
     return dist(gen) == 0 ? 'P' : 'S'; // Randomly choose between 'P' and 'S'
 }
 
+/**
+ * @brief Gets the engine used by the default Request constructor.
+ * 
+ * Seeded once per thread from std::random_device, instead of building and
+ * seeding a new engine for every value drawn.
+ * 
+ * @return A reference to this thread's engine.
+ */
+std::mt19937& defaultEngine() {
+    thread_local std::mt19937 gen(std::random_device{}());
+    return gen;
+}
+
 /**
  * @brief Constructs a Request object with the provided parameters.
  * 
@@ -68,16 +77,36 @@ char generateRandomJobType() {
  * @param jobType The type of the job ('P' for processing, 'S' for streaming).
  */
 Request::Request(const std::string& ipIn, const std::string& ipOut, int time, char jobType)
-    : ipIn(ipIn), ipOut(ipOut), time(time), jobType(jobType) {}
+    : ipInAddress(addressOf(ipIn)), ipOutAddress(addressOf(ipOut)), ipIn(ipIn), ipOut(ipOut), time(time), jobType(jobType) {}
+
+/**
+ * @brief Constructs a Request object from numeric addresses.
+ * 
+ * @param ipIn The incoming address in host byte order.
+ * @param ipOut The outgoing address in host byte order.
+ * @param time The time required to process the request.
+ * @param jobType The type of the job ('P' for processing, 'S' for streaming).
+ */
+Request::Request(std::uint32_t ipIn, std::uint32_t ipOut, int time, char jobType)
+    : ipInAddress(ipIn), ipOutAddress(ipOut), ipIn(ipv4ToString(ipIn)), ipOut(ipv4ToString(ipOut)), time(time), jobType(jobType) {}
 
 /**
  * @brief Constructs a Request object with randomly generated parameters.
  * 
  * This constructor generates random values for the incoming/outgoing IP addresses,
- * the processing time, and the job type.
+ * the processing time, and the job type, using a per-thread engine seeded from std::random_device.
+ */
+Request::Request() : Request(defaultEngine()) {}
+
+/**
+ * @brief Constructs a Request object with parameters drawn from the given engine.
+ * 
+ * @param gen The random engine to draw from.
  */
-Request::Request()
-    : ipIn(generateRandomIp()), ipOut(generateRandomIp()), time(generateRandomTime()), jobType(generateRandomJobType()) {}
+Request::Request(std::mt19937& gen)
+    : ipInAddress(generateRandomIp(gen)), ipOutAddress(generateRandomIp(gen)),
+      ipIn(ipv4ToString(ipInAddress)), ipOut(ipv4ToString(ipOutAddress)),
+      time(generateRandomTime(gen)), jobType(generateRandomJobType(gen)) {}
 
 /**
  * @brief Gets the incoming IP address of the request.
@@ -95,6 +124,22 @@ std::string Request::getIpOut() const {
     return ipOut;
 }
 
+/**
+ * @brief Gets the incoming address as a number.
+ * @return The incoming address in host byte order, or 0 if malformed.
+ */
+std::uint32_t Request::getIpInAddress() const {
+    return ipInAddress;
+}
+
+/**
+ * @brief Gets the outgoing address as a number.
+ * @return The outgoing address in host byte order, or 0 if malformed.
+ */
+std::uint32_t Request::getIpOutAddress() const {
+    return ipOutAddress;
+}
+
 /**
  * @brief Gets the time required to process the request.
  * @return The processing time as an integer.
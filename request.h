@@ -1,7 +1,9 @@
 #ifndef REQUEST_H
 #define REQUEST_H
 
+#include <cstdint>
 #include <string>
+#include <random>
 
 /**
  * @class Request
@@ -22,6 +24,16 @@ public:
      */
     Request(const std::string& ipIn, const std::string& ipOut, int time, char jobType);
 
+    /**
+     * @brief Constructs a Request from numeric IPv4 addresses, e.g. as read from live input.
+     * 
+     * @param ipIn The source address in host byte order.
+     * @param ipOut The destination address in host byte order.
+     * @param time The time in clock cycles required to process the request.
+     * @param jobType The type of job ('P' for processing, 'S' for streaming).
+     */
+    Request(std::uint32_t ipIn, std::uint32_t ipOut, int time, char jobType);
+
     /**
      * @brief Default constructor that generates a Request with random IP addresses and other parameters.
      * 
@@ -29,6 +41,16 @@ public:
      */
     Request();
 
+    /**
+     * @brief Constructs a Request with random IP addresses, time, and job type drawn from the given engine.
+     * 
+     * Requests built from an engine with a fixed seed are reproducible, which the sharded
+     * simulation relies on for deterministic results.
+     * 
+     * @param gen The random engine to draw from.
+     */
+    explicit Request(std::mt19937& gen);
+
     /**
      * @brief Gets the source IP address of the request.
      * 
@@ -43,6 +65,20 @@ public:
      */
     std::string getIpOut() const;
 
+    /**
+     * @brief Gets the source address as a number, parsed once when the request was built.
+     * 
+     * @return The source address in host byte order, or 0 if it was not a valid IPv4 address.
+     */
+    std::uint32_t getIpInAddress() const;
+
+    /**
+     * @brief Gets the destination address as a number, parsed once when the request was built.
+     * 
+     * @return The destination address in host byte order, or 0 if it was not a valid IPv4 address.
+     */
+    std::uint32_t getIpOutAddress() const;
+
     /**
      * @brief Gets the time required to process the request.
      * 
@@ -65,6 +101,8 @@ public:
     void displayRequest() const;
 
 private:
+    std::uint32_t ipInAddress;  /**< The source IP address in host byte order */
+    std::uint32_t ipOutAddress; /**< The destination IP address in host byte order */
     std::string ipIn;   /**< The source IP address */
     std::string ipOut;  /**< The destination IP address */
 
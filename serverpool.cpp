@@ -0,0 +1,128 @@
+#include "serverpool.h"
+#include <stdexcept>
+
+/**
+ * @brief Constructs a pool with fleetSize servers and no tenants.
+ * @param fleetSize Total number of servers.
+ */
+ServerPool::ServerPool(int fleetSize)
+    : fleetSize(fleetSize), unreserved(fleetSize), sharedFree(fleetSize) {}
+
+/**
+ * @brief Registers a tenant and reserves its minimum.
+ * @param minServers Guaranteed servers.
+ * @param maxServers Server limit.
+ * @return The tenant's ID.
+ */
+int ServerPool::addTenant(int minServers, int maxServers) {
+    if (minServers < 0 || maxServers < minServers) {
+        throw std::invalid_argument("Tenant quotas must satisfy 0 <= min <= max");
+    }
+    if (minServers > unreserved) {
+        throw std::invalid_argument("Tenant minimums exceed the fleet size");
+    }
+    unreserved -= minServers;
+    sharedFree.fetch_sub(minServers);
+
+    auto tenant = std::make_unique<Tenant>();
+    tenant->minServers = minServers;
+    tenant->maxServers = maxServers;
+    tenants.push_back(std::move(tenant));
+    return int(tenants.size()) - 1;
+}
+
+/**
+ * @brief Leases a server: below the minimum from the tenant's reservation, above it from the shared reserve.
+ * @param tenant The tenant's ID.
+ * @return true if granted.
+ */
+bool ServerPool::lease(int tenant) {
+    Tenant& state = *tenants[tenant];
+    int held = state.leased.load(std::memory_order_relaxed);
+    if (held >= state.maxServers) {
+        state.denied.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (held >= state.minServers) {
+        int free = sharedFree.load(std::memory_order_relaxed);
+        do {
+            if (free <= 0) {
+                state.denied.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!sharedFree.compare_exchange_weak(free, free - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    }
+    state.leased.store(held + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Returns a server; servers above the minimum go back to the shared reserve.
+ * @param tenant The tenant's ID.
+ * @return true if the tenant held a server.
+ */
+bool ServerPool::release(int tenant) {
+    Tenant& state = *tenants[tenant];
+    int held = state.leased.load(std::memory_order_relaxed);
+    if (held == 0) {
+        return false;
+    }
+    if (held > state.minServers) {
+        sharedFree.fetch_add(1, std::memory_order_acq_rel);
+    }
+    state.leased.store(held - 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Gets the number of servers a tenant holds.
+ * @param tenant The tenant's ID.
+ * @return The lease count.
+ */
+int ServerPool::getLeased(int tenant) const {
+    return tenants[tenant]->leased.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Gets a tenant's minimum.
+ * @param tenant The tenant's ID.
+ * @return The minimum.
+ */
+int ServerPool::getMinServers(int tenant) const {
+    return tenants[tenant]->minServers;
+}
+
+/**
+ * @brief Gets a tenant's maximum.
+ * @param tenant The tenant's ID.
+ * @return The maximum.
+ */
+int ServerPool::getMaxServers(int tenant) const {
+    return tenants[tenant]->maxServers;
+}
+
+/**
+ * @brief Gets the number of refused leases for a tenant.
+ * @param tenant The tenant's ID.
+ * @return The denied count.
+ */
+long long ServerPool::getDenied(int tenant) const {
+    return tenants[tenant]->denied.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the free part of the shared reserve.
+ * @return The number of unleased shared servers.
+ */
+int ServerPool::getSharedFree() const {
+    return sharedFree.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Gets the fleet size.
+ * @return The total number of servers.
+ */
+int ServerPool::getFleetSize() const {
+    return fleetSize;
+}
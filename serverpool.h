@@ -0,0 +1,111 @@
+#ifndef SERVERPOOL_H
+#define SERVERPOOL_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ServerPool
+ * @brief A fixed-size fleet of servers shared by several load balancers (tenants).
+ *
+ * Every tenant is guaranteed its minimum number of servers and may hold up to
+ * its maximum. Servers above the minimums form a shared reserve that tenants
+ * lease from and return to as their backlogs change, so capacity moves to the
+ * busiest tenant while the fleet size never changes.
+ *
+ * Leasing and returning are lock-free: the shared reserve is a single atomic
+ * counter updated with compare-and-swap, and each tenant's lease count has a
+ * single writer (the thread running that tenant's balancer). Tenants are added
+ * before any balancer starts running.
+ */
+class ServerPool {
+public:
+    /**
+     * @brief Constructs a ServerPool.
+     * @param fleetSize Total number of servers in the fleet.
+     */
+    explicit ServerPool(int fleetSize);
+
+    /**
+     * @brief Registers a tenant. Not thread-safe; call before leasing starts.
+     * @param minServers Servers always available to the tenant.
+     * @param maxServers Most servers the tenant may hold at once.
+     * @return The tenant's ID.
+     * @throws std::invalid_argument if the quotas are inconsistent or the minimums exceed the fleet.
+     */
+    int addTenant(int minServers, int maxServers);
+
+    /**
+     * @brief Leases one server to a tenant.
+     * @param tenant The tenant's ID.
+     * @return true if a server was granted, false if the tenant is at its maximum or the reserve is empty.
+     */
+    bool lease(int tenant);
+
+    /**
+     * @brief Returns one of a tenant's servers to the pool.
+     * @param tenant The tenant's ID.
+     * @return true if the tenant held a server to return.
+     */
+    bool release(int tenant);
+
+    /**
+     * @brief Gets the number of servers a tenant holds.
+     * @param tenant The tenant's ID.
+     * @return The tenant's current lease count.
+     */
+    int getLeased(int tenant) const;
+
+    /**
+     * @brief Gets a tenant's guaranteed minimum.
+     * @param tenant The tenant's ID.
+     * @return The minimum number of servers.
+     */
+    int getMinServers(int tenant) const;
+
+    /**
+     * @brief Gets a tenant's maximum.
+     * @param tenant The tenant's ID.
+     * @return The maximum number of servers.
+     */
+    int getMaxServers(int tenant) const;
+
+    /**
+     * @brief Gets the number of lease requests refused for a tenant.
+     * @param tenant The tenant's ID.
+     * @return The number of denied leases.
+     */
+    long long getDenied(int tenant) const;
+
+    /**
+     * @brief Gets the number of shared servers not leased by anyone.
+     * @return The free shared reserve.
+     */
+    int getSharedFree() const;
+
+    /**
+     * @brief Gets the fleet size.
+     * @return The total number of servers.
+     */
+    int getFleetSize() const;
+
+private:
+    /**
+     * @struct Tenant
+     * @brief Quotas and lease state of one tenant, on its own cache line.
+     */
+    struct alignas(64) Tenant {
+        int minServers;                  ///< Guaranteed servers
+        int maxServers;                  ///< Server limit
+        std::atomic<int> leased{0};      ///< Servers currently held
+        std::atomic<long long> denied{0}; ///< Lease requests refused
+    };
+
+    int fleetSize;                                ///< Total servers in the fleet
+    int unreserved;                               ///< Servers not covered by any tenant minimum
+    std::atomic<int> sharedFree;                  ///< Unreserved servers not currently leased
+    std::vector<std::unique_ptr<Tenant>> tenants; ///< Registered tenants
+};
+
+#endif // SERVERPOOL_H
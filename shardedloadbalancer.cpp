@@ -0,0 +1,282 @@
+#include "shardedloadbalancer.h"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+// Set from a signal handler and read once per epoch at the barrier
+static std::atomic<bool> abortRequested{false};
+
+/**
+ * @brief Constructs a ShardedLoadBalancer and splits the servers evenly across shards.
+ * @param numServers Total number of web servers.
+ * @param runtime The total runtime of the simulation in clock cycles.
+ * @param numShards Number of shards (clamped to [1, numServers]).
+ * @param seed Seed shared by all shard engines.
+ * @param epochLength Clock cycles between barriers.
+ * @param arrivalRate Per-server, per-cycle arrival probability.
+ */
+ShardedLoadBalancer::ShardedLoadBalancer(int numServers, int runtime, int numShards, std::uint32_t seed, int epochLength,
+                                         double arrivalRate)
+    : numServers(numServers), runtime(runtime), epochLength(std::max(1, epochLength)),
+      arrivalRate(std::clamp(arrivalRate, 0.0, 1.0)),
+      interruptedAt(0) {
+    numShards = std::clamp(numShards, 1, std::max(1, numServers));
+    shards = std::vector<Shard>(numShards); // Built in place: shards hold move-only servers
+
+    int nextServerId = 1; // Server IDs start from 1 and are unique across shards
+    for (int s = 0; s < numShards; ++s) {
+        Shard& shard = shards[s];
+        int shardServers = numServers / numShards + (s < numServers % numShards ? 1 : 0);
+        shard.servers.reserve(shardServers);
+        for (int i = 0; i < shardServers; ++i) {
+            shard.servers.emplace_back(WebServer(nextServerId++, false, false));
+        }
+        shard.busyUntil.assign(shardServers, 0);
+
+        // Each shard's stream depends only on the seed and its index, never on the thread running it
+        std::seed_seq seq{seed, static_cast<std::uint32_t>(s)};
+        shard.gen.seed(seq);
+    }
+}
+
+/**
+ * @brief Fills each shard's queue with requestsPerServer requests for each of its servers.
+ * @param requestsPerServer Number of initial requests per server.
+ */
+void ShardedLoadBalancer::generateRandomRequests(int requestsPerServer) {
+    for (auto& shard : shards) {
+        int count = requestsPerServer * int(shard.servers.size());
+        for (int i = 0; i < count; ++i) {
+            shard.requestQueue.push(Request(shard.gen));
+        }
+    }
+}
+
+/**
+ * @brief Runs all shards in lock-step epochs on numThreads threads.
+ *
+ * Each epoch has two phases separated by barriers: every shard first drains
+ * its mailbox, advances epochLength cycles and publishes its queue size; then
+ * every shard compares its published size with the next shard's and posts any
+ * excess to that shard's mailbox. Each mailbox has a single writer and is only
+ * read after the following barrier, so no locks are needed. An interrupt is
+ * sampled once per barrier by its completion step, so every worker sees the
+ * same decision and all of them stop after the same epoch.
+ *
+ * @param numThreads Number of worker threads (clamped to [1, number of shards]).
+ */
+void ShardedLoadBalancer::balanceLoad(int numThreads) {
+    int numShards = shards.size();
+    numThreads = std::clamp(numThreads, 1, numShards);
+    bool stopping = false;
+    std::barrier sync(numThreads, [&]() noexcept { stopping = abortRequested.load(std::memory_order_relaxed); });
+
+    auto worker = [&](int threadIndex) {
+        for (int first = 1; first <= runtime; first += epochLength) {
+            int last = std::min(runtime, first + epochLength - 1);
+
+            for (int s = threadIndex; s < numShards; s += numThreads) {
+                drainMailbox(shards[s]);
+                runEpoch(shards[s], first, last);
+                shards[s].queueSnapshot = shards[s].requestQueue.size();
+            }
+            sync.arrive_and_wait();
+
+            for (int s = threadIndex; s < numShards; s += numThreads) {
+                postMigrations(s);
+            }
+            sync.arrive_and_wait();
+
+            if (stopping) {
+                if (threadIndex == 0) {
+                    interruptedAt = last;
+                }
+                break;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Requests posted at the final barrier are still waiting in mailboxes
+    for (auto& shard : shards) {
+        drainMailbox(shard);
+    }
+}
+
+/**
+ * @brief Advances a shard through one epoch: new arrivals, then dispatch to every free server.
+ * @param shard The shard to advance.
+ * @param firstCycle First clock cycle of the epoch.
+ * @param lastCycle Last clock cycle of the epoch.
+ */
+void ShardedLoadBalancer::runEpoch(Shard& shard, int firstCycle, int lastCycle) {
+    std::binomial_distribution<int> arrivals(shard.servers.size(), arrivalRate);
+
+    for (int cycle = firstCycle; cycle <= lastCycle; ++cycle) {
+        // Randomly generated requests, scaled with the size of the shard
+        int newRequests = arrivals(shard.gen);
+        for (int i = 0; i < newRequests; ++i) {
+            shard.requestQueue.push(Request(shard.gen));
+        }
+
+        // Assign queued requests to every server that is free in this cycle
+        for (int i = 0; i < int(shard.servers.size()) && !shard.requestQueue.empty(); ++i) {
+            if (shard.busyUntil[i] > cycle) {
+                continue;
+            }
+            const Request& nextRequest = shard.requestQueue.front();
+            if (shard.servers[i].processRequest(nextRequest, cycle, runtime)) {
+                shard.busyUntil[i] = cycle + nextRequest.getTime();
+                shard.requestsFinished++;
+            } else {
+                shard.requestsRejected++;
+            }
+            shard.requestQueue.pop();
+        }
+    }
+}
+
+/**
+ * @brief Sends half of the queue difference to the next shard when this shard is more loaded.
+ * @param index Index of the sending shard.
+ */
+void ShardedLoadBalancer::postMigrations(int index) {
+    int numShards = shards.size();
+    if (numShards < 2) {
+        return;
+    }
+    Shard& shard = shards[index];
+    Shard& next = shards[(index + 1) % numShards];
+
+    // Only the snapshots published before the barrier are read, never the live queues
+    int excess = (shard.queueSnapshot - next.queueSnapshot) / 2;
+    for (int i = 0; i < excess; ++i) {
+        next.mailbox.push_back(std::move(shard.requestQueue.front()));
+        shard.requestQueue.pop();
+    }
+    shard.requestsMigrated += std::max(0, excess);
+}
+
+/**
+ * @brief Appends the requests received from the previous shard to the shard's queue.
+ * @param shard The receiving shard.
+ */
+void ShardedLoadBalancer::drainMailbox(Shard& shard) {
+    for (auto& request : shard.mailbox) {
+        shard.requestQueue.push(std::move(request));
+    }
+    shard.mailbox.clear();
+}
+
+/**
+ * @brief Marks the simulation as interrupted; every worker stops at the next epoch barrier.
+ */
+void ShardedLoadBalancer::requestAbort() {
+    abortRequested.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of requests still queued in all shards.
+ * @return The total queue size.
+ */
+long long ShardedLoadBalancer::getRequestQueueSize() const {
+    long long total = 0;
+    for (const auto& shard : shards) {
+        total += shard.requestQueue.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the number of requests processed by all shards.
+ * @return The total number of finished requests.
+ */
+long long ShardedLoadBalancer::getRequestsFinished() const {
+    long long total = 0;
+    for (const auto& shard : shards) {
+        total += shard.requestsFinished;
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the number of requests rejected by all shards.
+ * @return The total number of rejected requests.
+ */
+long long ShardedLoadBalancer::getRequestsRejected() const {
+    long long total = 0;
+    for (const auto& shard : shards) {
+        total += shard.requestsRejected;
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the number of requests migrated between shards.
+ * @return The total number of migrated requests.
+ */
+long long ShardedLoadBalancer::getRequestsMigrated() const {
+    long long total = 0;
+    for (const auto& shard : shards) {
+        total += shard.requestsMigrated;
+    }
+    return total;
+}
+
+/**
+ * @brief Prints the initial status including shard layout and queue size.
+ */
+void ShardedLoadBalancer::printStartStatus() {
+    if constexpr (!logEnabled<LOG_BALANCER, LogLevel::Summary>()) {
+        return;
+    }
+    std::ofstream logFile("output.txt", std::ios::app);
+    std::cout << "-------------------------------------------------------" << std::endl;
+    logFile << "-------------------------------------------------------" << std::endl;
+    std::cout << "Start ShardedLoadBalancer Status: " << std::endl;
+    logFile << "Start ShardedLoadBalancer Status: " << std::endl;
+    std::cout << "Servers: " << numServers << " in " << shards.size() << " shards" << std::endl;
+    logFile << "Servers: " << numServers << " in " << shards.size() << " shards" << std::endl;
+    std::cout << "Starting with full queue size: " << getRequestQueueSize() << std::endl;
+    logFile << "Starting with full queue size: " << getRequestQueueSize() << std::endl;
+    std::cout << "Clock cycles: " << runtime << " | Epoch length: " << epochLength << " | Arrival rate: " << arrivalRate << std::endl;
+    logFile << "Clock cycles: " << runtime << " | Epoch length: " << epochLength << " | Arrival rate: " << arrivalRate << std::endl;
+    std::cout << "-------------------------------------------------------" << std::endl;
+    logFile << "-------------------------------------------------------" << std::endl;
+    logFile.close();
+}
+
+/**
+ * @brief Prints the final status including totals across all shards.
+ */
+void ShardedLoadBalancer::printEndStatus() {
+    std::ofstream logFile("output.txt", std::ios::app);
+    std::cout << "End ShardedLoadBalancer Status: " << std::endl;
+    logFile << "End ShardedLoadBalancer Status: " << std::endl;
+    if (interruptedAt > 0) {
+        std::cout << "Simulation interrupted after clock cycle " << interruptedAt << std::endl;
+        logFile << "Simulation interrupted after clock cycle " << interruptedAt << std::endl;
+    }
+    std::cout << "Remaining requests in the queue: " << getRequestQueueSize() << std::endl;
+    logFile << "Remaining requests in the queue: " << getRequestQueueSize() << std::endl;
+    std::cout << "Requests processed: " << getRequestsFinished() << std::endl;
+    logFile << "Requests processed: " << getRequestsFinished() << std::endl;
+    std::cout << "Requests rejected/discarded: " << getRequestsRejected() << std::endl;
+    logFile << "Requests rejected/discarded: " << getRequestsRejected() << std::endl;
+    std::cout << "Requests migrated between shards: " << getRequestsMigrated() << std::endl;
+    logFile << "Requests migrated between shards: " << getRequestsMigrated() << std::endl;
+    std::cout << "-------------------------------------------------------" << std::endl;
+    logFile << "-------------------------------------------------------" << std::endl;
+    logFile.close();
+}
@@ -0,0 +1,140 @@
+#ifndef SHARDEDLOADBALANCER_H
+#define SHARDEDLOADBALANCER_H
+
+#include "request.h"
+#include "webserver.h"
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <vector>
+
+/**
+ * @class ShardedLoadBalancer
+ * @brief Simulates one very large cluster in parallel by splitting its servers into shards.
+ *
+ * Each shard owns a slice of the servers, its own request queue and its own
+ * random engine. Shards advance independently for one epoch of clock cycles,
+ * then meet at a barrier where overloaded shards hand part of their backlog to
+ * the next shard through that shard's mailbox. Because every shard's engine is
+ * seeded from the shard index and migration only reads queue sizes taken at the
+ * barrier, results for a given seed and shard count do not depend on how many
+ * threads run the shards.
+ *
+ * This is a separate, simpler model than LoadBalancer, not a sharded copy of
+ * it. Each server receives a new request with a fixed probability per cycle
+ * (binomial arrivals), and every free server takes a request each cycle.
+ * There is no autoscaling, flow table, flight recorder or dump trigger, and
+ * shard servers keep no log entries, so memory stays bounded on long runs.
+ */
+class ShardedLoadBalancer {
+public:
+    /**
+     * @brief Constructs a ShardedLoadBalancer.
+     * @param numServers Total number of web servers across all shards.
+     * @param runtime The total runtime (in clock cycles) of the simulation.
+     * @param numShards Number of shards the servers are split into.
+     * @param seed Seed for every shard's random engine.
+     * @param epochLength Clock cycles each shard advances between barriers.
+     * @param arrivalRate Probability that a server receives a new request in a cycle, clamped to [0, 1].
+     */
+    ShardedLoadBalancer(int numServers, int runtime, int numShards, std::uint32_t seed, int epochLength = 10,
+                        double arrivalRate = 0.05);
+
+    /**
+     * @brief Fills every shard's queue with random requests.
+     * @param requestsPerServer Number of requests per server to start with.
+     */
+    void generateRandomRequests(int requestsPerServer);
+
+    /**
+     * @brief Runs the simulation using the given number of threads.
+     * @param numThreads Worker threads; shards are assigned to them round-robin.
+     */
+    void balanceLoad(int numThreads);
+
+    /**
+     * @brief Asks the running simulation to stop after the current epoch.
+     * Safe to call from a signal handler.
+     */
+    static void requestAbort();
+
+    /**
+     * @brief Gets the number of requests left in all shard queues.
+     * @return The total queue size.
+     */
+    long long getRequestQueueSize() const;
+
+    /**
+     * @brief Gets the number of finished requests across all shards.
+     * @return The total number of processed requests.
+     */
+    long long getRequestsFinished() const;
+
+    /**
+     * @brief Gets the number of rejected requests across all shards.
+     * @return The total number of rejected requests.
+     */
+    long long getRequestsRejected() const;
+
+    /**
+     * @brief Gets the number of requests moved between shards.
+     * @return The total number of migrated requests.
+     */
+    long long getRequestsMigrated() const;
+
+    /**
+     * @brief Prints the initial status of the simulation.
+     */
+    void printStartStatus();
+
+    /**
+     * @brief Prints the final status of the simulation.
+     */
+    void printEndStatus();
+
+private:
+    /**
+     * @struct Shard
+     * @brief The state owned by a single shard.
+     */
+    struct Shard {
+        std::vector<WebServer> servers;  ///< Servers owned by this shard
+        std::vector<int> busyUntil;      ///< Cycle at which each server becomes free again
+        std::queue<Request> requestQueue; ///< Requests waiting in this shard
+        std::vector<Request> mailbox;    ///< Requests sent by the previous shard at the last barrier
+        std::mt19937 gen;                ///< Shard-local random engine
+        int queueSnapshot = 0;           ///< Queue size published at the barrier
+        long long requestsFinished = 0;  ///< Requests processed by this shard
+        long long requestsRejected = 0;  ///< Requests this shard could not finish in time
+        long long requestsMigrated = 0;  ///< Requests this shard sent to the next shard
+    };
+
+    /**
+     * @brief Advances one shard through the clock cycles [firstCycle, lastCycle].
+     * @param shard The shard to advance.
+     * @param firstCycle First cycle of the epoch.
+     * @param lastCycle Last cycle of the epoch.
+     */
+    void runEpoch(Shard& shard, int firstCycle, int lastCycle);
+
+    /**
+     * @brief Moves part of a shard's backlog into the next shard's mailbox if it is more loaded.
+     * @param index Index of the sending shard.
+     */
+    void postMigrations(int index);
+
+    /**
+     * @brief Moves requests received in a shard's mailbox into its queue.
+     * @param shard The receiving shard.
+     */
+    void drainMailbox(Shard& shard);
+
+    std::vector<Shard> shards;  ///< All shards of the cluster
+    int numServers;             ///< Total number of servers
+    int runtime;                ///< Total runtime in clock cycles
+    int epochLength;            ///< Clock cycles between barriers
+    double arrivalRate;         ///< Probability that a server receives a new request in a cycle
+    int interruptedAt;          ///< Last clock cycle run before an interrupt, 0 if the run completed
+};
+
+#endif // SHARDEDLOADBALANCER_H
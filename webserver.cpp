@@ -6,8 +6,12 @@
  * @brief Constructor to initialize the WebServer with an ID.
  * 
  * @param id The ID of the server being initialized.
+ * @param logging Whether processing is logged.
+ * @param recording Whether the server keeps a flight recorder.
  */
-WebServer::WebServer(int id) : serverId(id), idle(true) {}
+WebServer::WebServer(int id, bool logging, bool recording)
+    : serverId(id), idle(true), logging(logging),
+      recorder(recording ? std::make_unique<ServerFlightRecorder>() : nullptr) {}
 
 /**
  * @brief Method to process a request assigned to the server.
@@ -19,31 +23,48 @@ WebServer::WebServer(int id) : serverId(id), idle(true) {}
  * @param request The request object containing details like time, IPs, and job type.
  * @param currentCycle The current clock cycle at which the request is assigned.
  * @param duration The total runtime of the load balancer.
+ * @return True if the request was processed, false if it was rejected.
  */
-void WebServer::processRequest(const Request& request, int currentCycle, int duration) {
-    // Check if the request can be processed within the remaining duration
-    if (request.getTime() + currentCycle > duration) {
-        logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
-                   ": Request from " + request.getIpIn() + " to " + request.getIpOut() +
-                   " cannot be processed within the time duration.");
-        return;
+bool WebServer::processRequest(const Request& request, int currentCycle, int duration) {
+    // Check if the request can be processed within the remaining duration,
+    // comparing against what is left so a long task time cannot overflow
+    if (request.getTime() > duration - currentCycle) {
+        if (recorder) {
+            recorder->record({currentCycle, FlightEventType::Reject, serverId, -1, request.getTime()});
+        }
+        if constexpr (logEnabled<LOG_SERVER>()) {
+            if (logging) {
+                logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                           ": Request from " + request.getIpIn() + " to " + request.getIpOut() +
+                           " cannot be processed within the time duration.");
+            }
+        }
+        return false;
     }
 
     // Mark the server as busy
     idle = false;
+    if (recorder) {
+        recorder->record({currentCycle, FlightEventType::Dispatch, serverId, -1, request.getTime()});
+    }
 
     // Display the request being processed
-    logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
-               ": WebServer " + std::to_string(serverId) + " is processing request from " +
-               request.getIpIn() + " to " + request.getIpOut() +
-               " | Job Type: " + (request.getJobType() == 'P' ? "Processing " : "Streaming | Task Time: ") +
-               std::to_string(request.getTime()) + " cycles | ");
+    if constexpr (logEnabled<LOG_SERVER>()) {
+        if (logging) {
+            logMessage(currentCycle, "Clock cycle " + std::to_string(currentCycle) +
+                       ": WebServer " + std::to_string(serverId) + " is processing request from " +
+                       request.getIpIn() + " to " + request.getIpOut() +
+                       " | Job Type: " + (request.getJobType() == 'P' ? "Processing " : "Streaming | Task Time: ") +
+                       std::to_string(request.getTime()) + " cycles | ");
+        }
+    }
 
     // Simulate the request processing based on the request's time
     simulateRequestTime(request, request.getTime(), currentCycle);
 
     // After processing, mark the server as idle again
     idle = true;
+    return true;
 }
 
 /**
@@ -74,9 +95,16 @@ void WebServer::simulateRequestTime(const Request& request, int cycles, int curr
     while (std::chrono::high_resolution_clock::now() < end) {
         // Busy-wait loop
     }
-    logMessage(cycles + currentCycle, "Clock cycle " + std::to_string(cycles + currentCycle) +
-               ": WebServer " + std::to_string(serverId) + " finished processing request from " +
-               request.getIpIn() + " to " + request.getIpOut());
+    if (recorder) {
+        recorder->record({cycles + currentCycle, FlightEventType::Finish, serverId, -1, cycles});
+    }
+    if constexpr (logEnabled<LOG_SERVER>()) {
+        if (logging) {
+            logMessage(cycles + currentCycle, "Clock cycle " + std::to_string(cycles + currentCycle) +
+                       ": WebServer " + std::to_string(serverId) + " finished processing request from " +
+                       request.getIpIn() + " to " + request.getIpOut());
+        }
+    }
 }
 
 /**
@@ -114,3 +142,17 @@ void WebServer::logMessage(int clockCycle, const std::string& message) {
 const std::vector<LogEntry>& WebServer::getLogEntries() const {
     return log;
 }
+
+/**
+ * @brief Get the flight recorder for the server.
+ * 
+ * The flight recorder always holds the server's most recent dispatch, finish
+ * and reject events, independent of the compile-time log level. A server
+ * built without one reports an empty recorder.
+ * 
+ * @return A reference to the server's flight recorder.
+ */
+const ServerFlightRecorder& WebServer::getFlightRecorder() const {
+    static const ServerFlightRecorder empty;
+    return recorder ? *recorder : empty;
+}
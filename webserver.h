@@ -2,6 +2,9 @@
 #define WEBSERVER_H
 
 #include "request.h"
+#include "logconfig.h"
+#include "flightrecorder.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,6 +19,9 @@ struct LogEntry {
     std::string message; /**< The log message detailing server activity */
 };
 
+/// Flight recorder kept by a WebServer unless it is built without one
+using ServerFlightRecorder = FlightRecorder<64>;
+
 /**
  * @class WebServer
  * @brief Represents a web server capable of processing requests and logging its activity.
@@ -29,8 +35,10 @@ public:
      * @brief Constructs a WebServer with a specified ID.
      * 
      * @param id The unique ID assigned to the server.
+     * @param logging Whether processing is logged; servers whose log is never printed turn it off.
+     * @param recording Whether to keep a flight recorder; servers that are never dumped turn it off.
      */
-    WebServer(int id);
+    WebServer(int id, bool logging = true, bool recording = true);
 
     /**
      * @brief Processes a request and logs the activity.
@@ -38,8 +46,9 @@ public:
      * @param request The request to be processed by the server.
      * @param currentCycle The current clock cycle during which the request starts processing.
      * @param duration The time duration (in clock cycles) for which the request is processed.
+     * @return true if the request was processed, false if it could not finish within the duration.
      */
-    void processRequest(const Request& request, int currentCycle, int duration);
+    bool processRequest(const Request& request, int currentCycle, int duration);
 
     /**
      * @brief Checks if the server is idle.
@@ -79,10 +88,19 @@ public:
      */
     const std::vector<LogEntry>& getLogEntries() const;
 
+    /**
+     * @brief Gets the server's flight recorder of recent events.
+     * 
+     * @return A const reference to the server's flight recorder.
+     */
+    const ServerFlightRecorder& getFlightRecorder() const;
+
 private:
     int serverId;        /**< Unique ID of the server */
     bool idle;           /**< Indicates whether the server is idle (true) or processing (false) */
+    bool logging;        /**< Whether request processing is logged */
     std::vector<LogEntry> log; /**< Stores log entries of server activities */
+    std::unique_ptr<ServerFlightRecorder> recorder; /**< Record of the server's most recent events, or nullptr if not kept */
 };
 
 #endif // WEBSERVER_H